@@ -16,6 +16,7 @@
 #include <ctype.h>
 #include <math.h>
 #include <time.h>
+#include <stdarg.h>
 
 
 
@@ -26,6 +27,7 @@
 
 // PLATFORM-DEPENDENT SLEEP FUNCTION 
 #ifdef _WIN32
+    #include <winsock2.h>   // before windows.h, which would otherwise pull in the old winsock.h
     #include <windows.h>
     #define SLEEP_FUNCTION(ms) Sleep(ms)
     #define CLEAR_COMMAND "cls"
@@ -42,15 +44,24 @@
 
 
 
-// SYSTEM CONSTANTS & DEFINITIONS
-#define MAX_EMPLOYEES 50
-#define ADMIN_PIN 1234
-#define FILENAME "MonthlyAttendance.txt"
-#define ATTENDANCE_FILE "employee_attendance.txt"
-#define MAX_STR 100
-#define STANDARD_WORKING_DAYS 22
-#define MAX_WORKING_DAYS 30
-#define MAX_ATTENDANCE_RECORDS 1000
+// PLATFORM-DEPENDENT FILE MAPPING, SYNC AND DIRECTORIES
+#ifdef _WIN32
+    #include <io.h>
+    #include <direct.h>
+    #define FSYNC_FILE(fp) _commit(_fileno(fp))
+    #define TRUNCATE_FILE(fp, size) _chsize(_fileno(fp), (size))
+    #define MAKE_DIRECTORY(path) _mkdir(path)
+    #define CHANGE_DIRECTORY(path) _chdir(path)
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <dirent.h>
+    #define FSYNC_FILE(fp) fsync(fileno(fp))
+    #define TRUNCATE_FILE(fp, size) ftruncate(fileno(fp), (size))
+    #define MAKE_DIRECTORY(path) mkdir(path, 0755)
+    #define CHANGE_DIRECTORY(path) chdir(path)
+#endif
 
 
 
@@ -59,11 +70,26 @@
 
 
 
-// DEDUCTION CONSTANTS 
-#define DEDUCTION_SSS_RATE 0.045f
-#define DEDUCTION_PHILHEALTH_RATE 0.025f
-#define DEDUCTION_PAGIBIG_RATE 0.02f
-#define OVERTIME_RATE_MULTIPLIER 1.25f
+// PLATFORM-DEPENDENT THREADS
+#ifdef _WIN32
+    typedef HANDLE WorkerThread;
+    typedef HANDLE WorkerSignal;    // auto-reset event
+    #define WORKER_RETURN DWORD WINAPI
+    #define YIELD_THREAD() SwitchToThread()
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    typedef pthread_t WorkerThread;
+    typedef struct {
+        pthread_mutex_t lock;
+        pthread_cond_t cond;
+        int raised;
+    } WorkerSignal;
+    #define WORKER_RETURN void *
+    #define YIELD_THREAD() sched_yield()
+#endif
+#include <stdatomic.h>
+#include <signal.h>
 
 
 
@@ -72,38 +98,44 @@
 
 
 
-// INCOME TAX TIERS (Updated 2024 Philippine Tax Table) 
-#define TAX_TIER_1_LIMIT 20833.00f
-#define TAX_TIER_2_LIMIT 33333.00f
-#define TAX_TIER_3_LIMIT 66667.00f
-#define TAX_TIER_4_LIMIT 166667.00f
-#define TAX_TIER_5_LIMIT 666667.00f
+// PLATFORM-DEPENDENT SOCKETS (link with -lws2_32 on Windows)
+#ifdef _WIN32
+    typedef SOCKET SocketHandle;
+    #define CLOSE_SOCKET(s) closesocket(s)
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    typedef int SocketHandle;
+    #define INVALID_SOCKET (-1)
+    #define CLOSE_SOCKET(s) close(s)
+#endif
 
-#define TAX_RATE_TIER_2 0.15f
-#define TAX_RATE_TIER_3 0.20f
-#define TAX_RATE_TIER_4 0.25f
-#define TAX_RATE_TIER_5 0.30f
-#define TAX_RATE_TIER_6 0.35f
 
-#define TAX_BASE_TIER_2 0.00f
-#define TAX_BASE_TIER_3 2500.00f
-#define TAX_BASE_TIER_4 10833.33f
-#define TAX_BASE_TIER_5 40833.33f
-#define TAX_BASE_TIER_6 200833.33f
 
 
 
 
 
 
+// SYSTEM CONSTANTS & DEFINITIONS
+#define ADMIN_PIN 1234
+#define FILENAME "MonthlyAttendance.txt"
+#define ATTENDANCE_FILE "employee_attendance.txt"           // single-file format of earlier versions
+#define ATTENDANCE_JOURNAL_FILE "employee_attendance.journal"
+#define JOURNAL_COMPACT_THRESHOLD 4096
+#define BINARY_FILENAME "MonthlyAttendance.bin"
+#define PAYROLL_JOURNAL_FILE "MonthlyAttendance.journal"
+#define ATTENDANCE_BINARY_FILE "employee_attendance.bin"    // single-file format of earlier versions
+#define SETTINGS_FILE "ers_settings.txt"
+#define QUIET_ENV_VAR "ERS_QUIET"
+#define MAX_STR 100
+#define STANDARD_WORKING_DAYS 22
+#define MAX_WORKING_DAYS 30
+#define DEFAULT_PAY_PERIOD_CUTOFF 15     // last day of the first semi-monthly period
+#define MAX_PAY_PERIOD_CUTOFF 27         // leaves every month a second period
 
-// POSITION DEFINITIONS 
-typedef enum { 
-    SERVICE_CREW, 
-    COOKER, 
-    COUNTER_CREW, 
-    NUM_POSITIONS 
-} PositionType;
 
 
 
@@ -111,13 +143,23 @@ typedef enum {
 
 
 
+// STORAGE CHUNK SIZES (records per chunk, as a power of two)
+#define EMPLOYEE_CHUNK_SHIFT 10
+#define ATTENDANCE_CHUNK_SHIFT 16
+#define ID_INDEX_MIN_CAPACITY 64
+#define DAY_INDEX_MIN_CAPACITY 1024
 
-const char *PositionNames[NUM_POSITIONS] = { 
-    "Service Crew", 
-    "Cooker", 
-    "Counter Crew" 
-};
+// EMPLOYEE ID RANGE (7-digit IDs)
+#define MIN_EMPLOYEE_ID 1000000
+#define MAX_EMPLOYEE_ID 9999999
+#define EMPLOYEE_ID_SPACE (MAX_EMPLOYEE_ID - MIN_EMPLOYEE_ID + 1)
 
+// CSV IMPORT AND EXPORT
+#define CSV_CHUNK_SIZE (1 << 16)        // bytes read at a time; also the longest row accepted
+#define CSV_MAX_FIELDS 16
+#define CSV_ROW_TOO_LONG -2
+#define CSV_IMPORT_BATCH 65536          // records for other months merged into their files at a time
+#define IMPORT_ID_BLOCK 256             // employee IDs reserved at a time for rows without one
 
 
 
@@ -125,12 +167,14 @@ const char *PositionNames[NUM_POSITIONS] = {
 
 
 
-const float PositionMonthlySalaries[NUM_POSITIONS] = {
-    18000.00f,
-    25000.00f,
-    35000.00f
-};
 
+// WRITE-BEHIND POLICY
+// Changed employees are collected and persisted together once SAVE_BATCH_SIZE changes are
+// pending or the oldest pending change is SAVE_DELAY_SECONDS old (checked after every admin
+// action), and always on logout and exit. Only derived figures (payroll results, attendance
+// totals) wait like this: an admin's add, update or remove is flushed as soon as it is made.
+#define SAVE_BATCH_SIZE 32
+#define SAVE_DELAY_SECONDS 30
 
 
 
@@ -138,463 +182,285 @@ const float PositionMonthlySalaries[NUM_POSITIONS] = {
 
 
 
-// ATTENDANCE STRUCTURES
-typedef struct {
-    int empID;
-    char date[11];
-    char timeIn[6];
-    float hoursWorked;
-    char status[20];
-    int isLate;
-    float overtimeHours;
-} AttendanceRecord;
 
+// PAYROLL WORKER POOL
+// Payroll is split into contiguous employee ranges, one per core (at most MAX_PAYROLL_WORKERS);
+// below PAYROLL_PARALLEL_THRESHOLD employees threads cost more than they save
+#define MAX_PAYROLL_WORKERS 64
+#define PAYROLL_PARALLEL_THRESHOLD 2048
 
+// Rows per 64-byte line of a working set column; worker ranges start on a multiple of this
+// so no two workers write the same cache line
+#define PAYROLL_BLOCK 8
 
 
 
 
 
 
-// EMPLOYEE STRUCTURE
-typedef struct {
-    int empID;
-    char name[50];
-    PositionType position;
-    float monthlySalary;
-    int daysWorked;
-    float totalOvertimeHours;
-    float totalHoursWorked;
-    float lastOvertimePay;
-    float lastDailyRate;
-    float lastAbsentDeduct;
-    float lastGrossPay;
-    float lastNetPay;
-    float lastSSS;
-    float lastPhilHealth;
-    float lastPagIBIG;
-    float lastIncomeTax;
-} Employee;
 
 
+// BULK PAYSLIP EXPORT
+// Every slip is rendered into its own PAYSLIP_BUFFER_SIZE slot of one allocation by the
+// worker pool, then written with a single write per file (or one write for the whole archive)
+#define PAYSLIP_BUFFER_SIZE 2048
+#define PAYSLIP_ARCHIVE_MAGIC "ERS PAYSLIP ARCHIVE 1"
+#define PAYSLIP_ARCHIVE_FILE "payslips.archive"
 
 
 
 
 
 
-// GLOBAL STORAGE
-Employee employees[MAX_EMPLOYEES];
-int employeeCount = 0;
 
-AttendanceRecord attendanceRecords[MAX_ATTENDANCE_RECORDS];
-int attendanceCount = 0;
 
+// ATTENDANCE PARTITIONS
+// Attendance is kept in one file per calendar month (attendance_YYYY-MM.txt, or .bin with
+// binary snapshots). Only the current month is loaded at startup; reports read earlier months
+// on demand and keep the last PARTITION_CACHE_SIZE of them in memory. The journal's GEN line
+// names the month it extends.
+#define ATTENDANCE_PARTITION_PREFIX "attendance_"
+#define PARTITION_CACHE_SIZE 6
 
 
 
 
 
 
-// Function Prototype
 
-// Utility Functions
-void clearInputBuffer(void);
-void pressEnterToContinue(void);
-int getIntInput(const char *prompt, int min, int max);
-void getStringInput(const char *prompt, char *out, int maxlen, int letters_spaces_only);
-void getCurrentDateTime(char *date, char *timeBuf);
 
-// Employee Management
-int generateEmployeeID(void);
-int findEmployeeIndexByID(int id);
-int findEmployeeIndexByName(const char *name);
-int isNameDuplicate(const char *name, int excludeID);
-PositionType getPositionTypeByName(const char *name);
-int strcasecmp(const char *s1, const char *s2);
+// KIOSK SERVER
+// `serve [port]` listens on 127.0.0.1 for kiosk clients sending "IN <id>" / "ABSENT <id>" lines
+#define KIOSK_DEFAULT_PORT 5150
+#define KIOSK_STOP_CHECK_MS 200    // longest idle wait, so a stop from Ctrl+C is noticed
 
-// File Operations
-void saveToFile(void);
-void loadFromFile(void);
-void saveAttendanceToFile(void);
-void loadAttendanceFromFile(void);
-void printPaySlipToFile(const Employee *e);
 
-// Menu Functions
-void mainMenu(void);
-void adminMenu(void);
-int verifyPin(void);
 
-// Employee Operations
-void viewEmployees(void);
-void addEmployee(void);
-void updateEmployee(void);
-void removeEmployee(void);
-void sortEmployeesByID(void);
-void sortEmployeesByName(void);
 
-// Salary Functions
-void calculateAndDisplaySalary(void);
-float calculateIncomeTax(float taxableIncome);
-void displayEmployeeSalarySlip(int id);
 
-// Attendance Functions
-void attendanceMenu(void);
-void recordTimeIn(void);
-void recordAbsent(void);
-void viewAttendance(void);
 
 
 
+// GROUP COMMIT
+// Journal lines are written and fsynced in batches; a punch is acknowledged only once its
+// batch is durable. A batch is committed when it holds commit_batch punches, or when the
+// queue runs dry and its oldest punch has waited commit_delay_ms (both kept in SETTINGS_FILE).
+// With a delay of 0 punches that arrive during one fsync simply share the next one.
+#define GROUP_COMMIT_DEFAULT_BATCH 64
+#define GROUP_COMMIT_DEFAULT_DELAY_MS 0
+#define GROUP_COMMIT_MAX_BATCH 4096
+#define GROUP_COMMIT_ATTEMPTS 3         // appends tried before a batch's punches are refused
+#define JOURNAL_LINE_SIZE 64
+#define GROUP_COMMIT_BUCKETS 5
 
 
 
 
 
-// Implementation
 
-// Clears the input buffer to prevent leftover input from affecting subsequent scanf calls
-void clearInputBuffer(void) {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF) {}
-}
 
 
+// BENCHMARK
+// `benchmark [max employees] [months]` builds synthetic datasets in BENCHMARK_DATA_DIR (1000
+// employees, then ten times more up to the maximum, each with one punch per employee per
+// weekday of every month), times the load, save, lookup, attendance and payroll paths on them
+// and appends one JSON line per measurement to BENCHMARK_OUTPUT_FILE
+#define BENCHMARK_DATA_DIR "bench_data"
+#define BENCHMARK_OUTPUT_FILE "bench_output.txt"
+#define BENCHMARK_DEFAULT_EMPLOYEES 100000
+#define BENCHMARK_MAX_EMPLOYEES 1000000
+#define BENCHMARK_MAX_MONTHS 12
+#define BENCHMARK_MAX_ATTENDANCE 100000000LL
+#define BENCHMARK_REPEATS 3
+#define BENCHMARK_LOOKUPS (1 << 20)
 
 
 
 
 
-// Prompts user to press Enter to continue and waits for input
-void pressEnterToContinue(void) {
-    printf("\n\t\t\t\t                                   Press Enter to continue...");
-    fflush(stdout);
-    clearInputBuffer();
-}
 
 
 
+// MONEY
+// Amounts are whole centavos in a 64-bit integer and rates are basis points (1/10000), so
+// payroll sums are exact and do not depend on evaluation order or thread count.
+// Text files and screens still show pesos with two decimals through PESOS().
+typedef long long Money;
+#define MONEY_SCALE 100
+#define RATE_SCALE 10000
+#define PESOS(m) ((double)(m) / MONEY_SCALE)
 
 
 
 
 
-// Generates a unique 7-digit employee ID (1000000-9999999)
-int generateEmployeeID(void) {
-    int id;
-    int attempts = 0;
-    int max_attempts = 100;
-    
-    srand(time(NULL));
-    
-    do {
-        id = 1000000 + (rand() % 9000000);
-        attempts++;
-        
-        if (attempts >= max_attempts) {
-            int max_id = 1000000;
-            for (int i = 0; i < employeeCount; i++) {
-                if (employees[i].empID > max_id) {
-                    max_id = employees[i].empID;
-                }
-            }
-            id = max_id + 1;
-            if (id > 9999999) id = 1000000;
-            break;
-        }
-    } while (findEmployeeIndexByID(id) != -1);
-    
-    return id;
-}
 
 
 
+// DEDUCTION CONSTANTS (basis points)
+#define DEDUCTION_SSS_RATE 450
+#define DEDUCTION_PHILHEALTH_RATE 250
+#define DEDUCTION_PAGIBIG_RATE 200
+#define OVERTIME_RATE_MULTIPLIER 12500
 
 
 
 
 
-// Searches for an employee by their ID and returns the index, or -1 if not found
-int findEmployeeIndexByID(int id) {
-    for (int i = 0; i < employeeCount; ++i) {
-        if (employees[i].empID == id) return i;
-    }
-    return -1;
-}
 
 
 
+// INCOME TAX TIERS (Updated 2024 Philippine Tax Table; limits and bases in centavos, rates in basis points)
+#define TAX_TIER_1_LIMIT 2083300LL
+#define TAX_TIER_2_LIMIT 3333300LL
+#define TAX_TIER_3_LIMIT 6666700LL
+#define TAX_TIER_4_LIMIT 16666700LL
+#define TAX_TIER_5_LIMIT 66666700LL
 
+#define TAX_RATE_TIER_2 1500
+#define TAX_RATE_TIER_3 2000
+#define TAX_RATE_TIER_4 2500
+#define TAX_RATE_TIER_5 3000
+#define TAX_RATE_TIER_6 3500
 
+#define TAX_BASE_TIER_2 0LL
+#define TAX_BASE_TIER_3 250000LL
+#define TAX_BASE_TIER_4 1083333LL
+#define TAX_BASE_TIER_5 4083333LL
+#define TAX_BASE_TIER_6 20083333LL
 
 
 
-// Searches for an employee by their name (case-insensitive) and returns the index, or -1 if not found
-int findEmployeeIndexByName(const char *name) {
-    for (int i = 0; i < employeeCount; ++i) {
-        if (strcasecmp(employees[i].name, name) == 0) return i;
-    }
-    return -1;
-}
 
 
 
 
+// POSITION DEFINITIONS 
+typedef enum { 
+    SERVICE_CREW, 
+    COOKER, 
+    COUNTER_CREW, 
+    NUM_POSITIONS 
+} PositionType;
 
 
 
 
-// Case-insensitive string comparison function
-int strcasecmp(const char *s1, const char *s2) {
-    while (*s1 && *s2) {
-        int diff = tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
-        if (diff != 0) return diff;
-        s1++;
-        s2++;
-    }
-    return tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
-}
 
 
 
 
+const char *PositionNames[NUM_POSITIONS] = { 
+    "Service Crew", 
+    "Cooker", 
+    "Counter Crew" 
+};
 
 
 
 
-// Checks if an employee name already exists in the system (excluding specified ID)
-int isNameDuplicate(const char *name, int excludeID) {
-    for (int i = 0; i < employeeCount; ++i) {
-        if (employees[i].empID != excludeID && strcasecmp(employees[i].name, name) == 0) {
-            return 1;
-        }
-    }
-    return 0;
-}
 
 
 
 
+const Money PositionMonthlySalaries[NUM_POSITIONS] = {
+    1800000,
+    2500000,
+    3500000
+};
 
 
 
 
-// Converts a position name string to its corresponding PositionType enum value
-PositionType getPositionTypeByName(const char *name) {
-    for (int i = 0; i < NUM_POSITIONS; i++) {
-        if (strcmp(name, PositionNames[i]) == 0) {
-            return (PositionType)i;
-        }
-    }
-    return SERVICE_CREW;
-}
 
 
 
 
+// ATTENDANCE STATUS DEFINITIONS
+typedef enum {
+    ATTENDANCE_PRESENT,
+    ATTENDANCE_ABSENT,
+    ATTENDANCE_LATE,
+    NUM_ATTENDANCE_STATUSES
+} AttendanceStatus;
 
 
 
 
-// Gets integer input from user with validation and range checking
-int getIntInput(const char *prompt, int min, int max) {
-    int value;
-    while (1) {
-        if (prompt) printf("%s", prompt);
-        if (scanf("%d", &value) != 1) {
-            printf("\t\t\t\t\tInvalid input. Please enter a valid number.\n");
-            clearInputBuffer();
-            continue;
-        }
-        clearInputBuffer();
-        if (value < min || value > max) {
-            printf("\t\t\t\t\tPlease enter a value between %d and %d.\n", min, max);
-            continue;
-        }
-        return value;
-    }
-}
 
 
 
 
+const char *AttendanceStatusNames[NUM_ATTENDANCE_STATUSES] = {
+    "Present",
+    "Absent",
+    "Late"
+};
 
 
 
 
-// Gets string input from user with validation, trimming, and optional character restrictions
-void getStringInput(const char *prompt, char *out, int maxlen, int letters_spaces_only) {
-    while (1) {
-        if (prompt) printf("%s", prompt);
-        if (!fgets(out, maxlen, stdin)) {
-            clearInputBuffer();
-            printf("\t\t\t\t\tInput error. Please try again.\n");
-            continue;
-        }
-        
-        size_t n = strlen(out);
-        if (n > 0 && out[n-1] == '\n') out[n-1] = '\0';
-        else if (n == (size_t)maxlen - 1) clearInputBuffer();
-        
-        char *start = out;
-        while (*start && isspace((unsigned char)*start)) start++;
-        char *end = out + strlen(out) - 1;
-        while (end > start && isspace((unsigned char)*end)) end--;
-        *(end + 1) = '\0';
-        
-        if (start != out) memmove(out, start, strlen(start) + 1);
-        
-        if (strlen(out) == 0) {
-            printf("\t\t\t                                         Input cannot be empty or just spaces.\n");
-            continue;
-        }
-        
-        if (letters_spaces_only) {
-            int ok = 1;
-            int has_letter = 0;
-            for (size_t i = 0; i < strlen(out); ++i) {
-                if (isalpha((unsigned char)out[i])) {
-                    has_letter = 1;
-                } else if (out[i] != ' ' && out[i] != '-' && out[i] != '.') {
-                    ok = 0;
-                    break;
-                }
-            }
-            if (!ok) {
-                printf("\t\t\t\t\tInvalid characters detected. Use only letters, spaces, hyphens, or periods.\n");
-                continue;
-            }
-            if (!has_letter) {
-                printf("\t\t\t\t\tName must contain at least one letter.\n");
-                continue;
-            }
-        }
-        
-        if (strlen(out) < 2) {
-            printf("\t\t\t\t\tName must be at least 2 characters long.\n");
-            continue;
-        }
-        
-        if (strlen(out) > 48) {
-            printf("\t\t\t\t\tName is too long. Maximum 48 characters.\n");
-            continue;
-        }
-        
-        return;
-    }
-}
 
 
 
 
+// PAY PERIOD DEFINITIONS
+// Salaries are quoted per month; a semi-monthly period pays half of it against half the
+// standard working days, and its tax is the monthly table applied to twice its gross, halved
+typedef enum {
+    PAY_PERIOD_MONTHLY,
+    PAY_PERIOD_SEMI_MONTHLY,
+    NUM_PAY_PERIOD_TYPES
+} PayPeriodType;
 
 
 
 
-// Gets the current system date and time formatted as YYYY-MM-DD and HH:MM
-void getCurrentDateTime(char *date, char *timeBuf) {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    sprintf(date, "%04d-%02d-%02d", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
-    sprintf(timeBuf, "%02d:%02d", tm.tm_hour, tm.tm_min);
-}
 
 
 
 
+const char *PayPeriodNames[NUM_PAY_PERIOD_TYPES] = {
+    "Monthly",
+    "Semi-monthly"
+};
 
 
 
 
-// FILE HANDLING
 
-// Saves all employee records to the payroll file
-void saveToFile(void) {
-    FILE *fp = fopen(FILENAME, "w");
-    if (!fp) {
-        printf("\n\t\t\t\t\tError: Unable to save data to %s\n", FILENAME);
-        return;
-    }
-    
-    fprintf(fp, "%d\n", employeeCount);
-    for (int i = 0; i < employeeCount; i++) {
-        fprintf(fp, "%d\n%s\n%s\n%.2f\n%d\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n",
-            employees[i].empID,
-            employees[i].name,
-            PositionNames[employees[i].position],
-            employees[i].monthlySalary,
-            employees[i].daysWorked,
-            employees[i].totalOvertimeHours,
-            employees[i].totalHoursWorked,
-            employees[i].lastOvertimePay,
-            employees[i].lastDailyRate,
-            employees[i].lastAbsentDeduct,
-            employees[i].lastGrossPay,
-            employees[i].lastNetPay,
-            employees[i].lastSSS,
-            employees[i].lastPhilHealth,
-            employees[i].lastPagIBIG,
-            employees[i].lastIncomeTax
-        );
-    }
-    fclose(fp);
-}
 
 
 
+// ATTENDANCE STRUCTURES
+// Kept to 16 bytes: dates and times are stored as integers and only turned back into
+// text for display and for the attendance file
+typedef struct {
+    int empID;
+    int day;                        // days since 1970-01-01
+    unsigned short timeIn;          // minutes since midnight
+    unsigned short hoursWorked;     // hundredths of an hour
+    unsigned short overtimeHours;   // hundredths of an hour
+    unsigned char status : 7;       // AttendanceStatus
+    unsigned char isLate : 1;
+    unsigned char reserved;
+} AttendanceRecord;
 
+_Static_assert(sizeof(AttendanceRecord) == 16, "AttendanceRecord should stay 16 bytes");
 
 
 
 
-// Loads all employee records from the payroll file
-void loadFromFile(void) {
-    FILE *fp = fopen(FILENAME, "r");
-    if (!fp) {
-        printf("\t\t\t\t\tNo existing payroll file found. Starting fresh.\n");
-        employeeCount = 0;
-        return;
-    }
-    
-    if (fscanf(fp, "%d\n", &employeeCount) != 1) {
-        printf("\t\t\t\t\tError reading employee count from file. Starting fresh.\n");
-        employeeCount = 0;
-        fclose(fp);
-        return;
-    }
 
-    char posName[50];
-    for (int i = 0; i < employeeCount && i < MAX_EMPLOYEES; i++) {
-        if (fscanf(fp, "%d\n", &employees[i].empID) != 1) break;
 
-        if (!fgets(employees[i].name, sizeof(employees[i].name), fp)) break;
-        employees[i].name[strcspn(employees[i].name, "\n")] = 0;
 
-        if (!fgets(posName, sizeof(posName), fp)) break;
-        posName[strcspn(posName, "\n")] = 0;
-        employees[i].position = getPositionTypeByName(posName);
-
-        if (fscanf(fp, "%f\n%d\n%f\n%f\n%f\n%f\n%f\n%f\n%f\n%f\n%f\n%f\n%f\n",
-            &employees[i].monthlySalary,
-            &employees[i].daysWorked,
-            &employees[i].totalOvertimeHours,
-            &employees[i].totalHoursWorked,
-            &employees[i].lastOvertimePay,
-            &employees[i].lastDailyRate,
-            &employees[i].lastAbsentDeduct,
-            &employees[i].lastGrossPay,
-            &employees[i].lastNetPay,
-            &employees[i].lastSSS,
-            &employees[i].lastPhilHealth,
-            &employees[i].lastPagIBIG,
-            &employees[i].lastIncomeTax) != 13) break;
-    }
 
-    if (employeeCount > 0) {
-        printf("\t\t\t\t\tLoaded %d employees and their payroll data from file.\n", employeeCount);
-    }
-    fclose(fp);
-}
+// ATTENDANCE SUMMARY (per-employee totals produced by aggregateAttendance)
+typedef struct {
+    int daysWorked;
+    int daysAbsent;
+    float overtimeHours;
+} AttendanceSummary;
 
 
 
@@ -603,28 +469,19 @@ void loadFromFile(void) {
 
 
 
-// Saves all attendance records to the attendance file
-void saveAttendanceToFile(void) {
-    FILE *fp = fopen(ATTENDANCE_FILE, "w");
-    if (!fp) {
-        printf("\n\t\t\t\t\tError: Unable to save attendance data to %s\n", ATTENDANCE_FILE);
-        return;
-    }
-    
-    fprintf(fp, "%d\n", attendanceCount);
-    for (int i = 0; i < attendanceCount; i++) {
-        fprintf(fp, "%d\n%s\n%s\n%.2f\n%s\n%d\n%.2f\n",
-            attendanceRecords[i].empID,
-            attendanceRecords[i].date,
-            attendanceRecords[i].timeIn,
-            attendanceRecords[i].hoursWorked,
-            attendanceRecords[i].status,
-            attendanceRecords[i].isLate,
-            attendanceRecords[i].overtimeHours
-        );
-    }
-    fclose(fp);
-}
+// PAYROLL RESULT (one employee's figures, produced by computePayroll)
+typedef struct {
+    Money dailyRate;
+    Money basicSalary;
+    Money absentDeduct;
+    Money grossPay;
+    Money sss;
+    Money philHealth;
+    Money pagIBIG;
+    Money incomeTax;
+    Money totalDeduction;
+    Money netSalary;
+} PayrollResult;
 
 
 
@@ -633,104 +490,97 @@ void saveAttendanceToFile(void) {
 
 
 
-// Loads all attendance records from the attendance file
-void loadAttendanceFromFile(void) {
-    FILE *fp = fopen(ATTENDANCE_FILE, "r");
-    if (!fp) {
-        printf("\t\t\t\t\tNo existing attendance file found. Starting fresh.\n");
-        attendanceCount = 0;
-        return;
-    }
-    
-    if (fscanf(fp, "%d\n", &attendanceCount) != 1) {
-        printf("\t\t\t\t\tError reading attendance count from file. Starting fresh.\n");
-        attendanceCount = 0;
-        fclose(fp);
-        return;
-    }
 
-    for (int i = 0; i < attendanceCount && i < MAX_ATTENDANCE_RECORDS; i++) {
-        if (fscanf(fp, "%d\n", &attendanceRecords[i].empID) != 1) break;
 
-        if (!fgets(attendanceRecords[i].date, sizeof(attendanceRecords[i].date), fp)) break;
-        attendanceRecords[i].date[strcspn(attendanceRecords[i].date, "\n")] = 0;
+// PAYROLL WORKING SET
+// Column-oriented copy of the payroll inputs and outputs so the kernel streams only the
+// fields it uses (the Employee record drags its 50-byte name along). Columns are sized to
+// a multiple of PAYROLL_BLOCK so worker ranges split on whole blocks; the padding rows are
+// zero and compute to zero pay.
+typedef struct {
+    int count;
+    int capacity;
+    int periodsPerMonth;    // pay periods per month for every row (see PayPeriodType)
+    Money *block;           // single allocation holding every column
+    Money *monthlySalary;
+    Money *daysWorked;
+    Money *dailyRate;
+    Money *basicSalary;
+    Money *absentDeduct;
+    Money *grossPay;
+    Money *sss;
+    Money *philHealth;
+    Money *pagIBIG;
+    Money *incomeTax;
+    Money *totalDeduction;
+    Money *netSalary;
+} PayrollColumns;
+
+#define PAYROLL_COLUMN_COUNT 12
+
+// One worker's share of the payroll run: employees [first, last) of the working set
+typedef struct {
+    int first;
+    int last;
+    PayrollColumns *columns;
+} PayrollRange;
 
-        if (!fgets(attendanceRecords[i].timeIn, sizeof(attendanceRecords[i].timeIn), fp)) break;
-        attendanceRecords[i].timeIn[strcspn(attendanceRecords[i].timeIn, "\n")] = 0;
+// One worker's share of a bulk payslip export: slips [first, last) of the batch
+typedef struct {
+    int first;
+    int last;
+    const int *slots;       // employee slot of each slip
+    char *buffer;           // PAYSLIP_BUFFER_SIZE bytes per slip
+    size_t *lengths;        // rendered length of each slip (0 if it did not fit)
+} PayslipRange;
 
-        if (fscanf(fp, "%f\n", &attendanceRecords[i].hoursWorked) != 1) break;
 
-        if (!fgets(attendanceRecords[i].status, sizeof(attendanceRecords[i].status), fp)) break;
-        attendanceRecords[i].status[strcspn(attendanceRecords[i].status, "\n")] = 0;
 
-        if (fscanf(fp, "%d\n%f\n", 
-            &attendanceRecords[i].isLate,
-            &attendanceRecords[i].overtimeHours) != 2) break;
-    }
 
-    if (attendanceCount > 0) {
-        printf("\t\t\t\t\tLoaded %d attendance records from file.\n", attendanceCount);
-    }
-    fclose(fp);
-}
 
 
 
 
+// EMPLOYEE STRUCTURE
+typedef struct {
+    int empID;
+    char name[50];
+    PositionType position;
+    Money monthlySalary;
+    int daysWorked;
+    float totalOvertimeHours;
+    float totalHoursWorked;
+    Money lastOvertimePay;
+    Money lastDailyRate;
+    Money lastAbsentDeduct;
+    Money lastGrossPay;
+    Money lastNetPay;
+    Money lastSSS;
+    Money lastPhilHealth;
+    Money lastPagIBIG;
+    Money lastIncomeTax;
+    int dirty;      // changed since the last save (cleared on load, not meaningful on disk)
+    unsigned int changeGeneration;      // bumped whenever a pay input changes (runtime only)
+    unsigned int computedGeneration;    // changeGeneration as of the last payroll computation
+} Employee;
 
 
 
 
-// Generates and saves a payslip to a text file for a specific employee
-void printPaySlipToFile(const Employee *e) {
-    char filename[MAX_STR];
-    sprintf(filename, "payslip_%d.txt", e->empID);
 
-    FILE *fp = fopen(filename, "w");
-    if (!fp) {
-        printf("\n\t\t\t\t                          ERROR: Unable to create file %s.\n", filename);
-        return;
-    }
 
-    float totalDeduction = e->lastSSS + e->lastPhilHealth + e->lastPagIBIG + e->lastIncomeTax;
-    float actualBasicPay = e->lastDailyRate * e->daysWorked;
-
-    fprintf(fp, "================================================\n");
-    fprintf(fp, "         OFFICIAL MONTHLY SALARY SLIP          \n");
-    fprintf(fp, "================================================\n");
-    fprintf(fp, "Employee ID:               %d\n", e->empID);
-    fprintf(fp, "Employee Name:             %s\n", e->name);
-    fprintf(fp, "Position:                  %s\n", PositionNames[e->position]);
-    fprintf(fp, "Fixed Monthly Salary Base: Php%.2f\n", e->monthlySalary);
-    fprintf(fp, "Standard Working Days:     %d\n", STANDARD_WORKING_DAYS);
-    fprintf(fp, "Daily Rate:                Php%.2f\n", e->lastDailyRate);
-    fprintf(fp, "Days Worked:               %d\n", e->daysWorked);
-    if ((STANDARD_WORKING_DAYS - e->daysWorked) > 0) {
-        fprintf(fp, "Days Absent:               %d\n", STANDARD_WORKING_DAYS - e->daysWorked);
-    }
-    fprintf(fp, "------------------------------------------------\n");
-    fprintf(fp, "EARNINGS:\n");
-    fprintf(fp, "  - Basic Salary (Days Worked):    Php%.2f\n", actualBasicPay);
-    // Overtime removed from slip 
-    if (e->lastAbsentDeduct > 0) {
-        fprintf(fp, "  - Less: Absent Deduction:         Php%.2f\n", e->lastAbsentDeduct);
-    }
-    fprintf(fp, "GROSS PAY:                         Php%.2f\n", e->lastGrossPay);
-    fprintf(fp, "------------------------------------------------\n");
-    fprintf(fp, "MANDATORY DEDUCTIONS:\n");
-    fprintf(fp, "  - SSS (4.5%%):                   Php%.2f\n", e->lastSSS);
-    fprintf(fp, "  - PhilHealth (2.5%%):            Php%.2f\n", e->lastPhilHealth);
-    fprintf(fp, "  - Pag-IBIG (2%%):                Php%.2f\n", e->lastPagIBIG);
-    fprintf(fp, "  - Withholding Tax:               Php%.2f\n", e->lastIncomeTax);
-    fprintf(fp, "------------------------------------------------\n");
-    fprintf(fp, "TOTAL DEDUCTIONS:                  Php%.2f\n", totalDeduction);
-    fprintf(fp, "NET SALARY (Take Home):            Php%.2f\n", e->lastNetPay);
-    fprintf(fp, "================================================\n");
 
-    fclose(fp);
-    printf("\n\t\t\t\t                          Salary Slip successfully saved to file: %s\n", filename);
-}
 
+// CHUNKED STORE
+// Records live in fixed-size chunks so that growing the store only allocates a new
+// chunk and extends the chunk directory; existing record pointers never move.
+typedef struct {
+    char **chunks;
+    int chunkCount;
+    int chunkCapacity;
+    int chunkShift;
+    size_t recordSize;
+} ChunkedStore;
 
 
 
@@ -738,229 +588,53 @@ void printPaySlipToFile(const Employee *e) {
 
 
 
-// ATTENDANCE SYSTEM 
 
-// Displays the attendance management menu and handles user choices
-void attendanceMenu(void) {
-    system(CLEAR_COMMAND);
-    int choice;
-    do {
-        printf("\n\t\t\t\t                                        ATTENDANCE MANAGEMENT\n");
-    printf("\n\t\t\t\t                                        1. Time In Today\n");
-    printf("\t\t\t\t                                        2. Absent\n");
-    printf("\t\t\t\t                                        3. BACK TO ADMIN MENU\n");
-    printf("\t\t\t\t                                        4. SORT EMPLOYEES BY ID (ascending)\n");
-        printf("\n\t\t\t\t                                          Choice: ");
-        
-        if (scanf("%d", &choice) != 1) {
-            printf("\n\t\t\t\t                                        Invalid input. Please enter a number.\n");
-            clearInputBuffer();
-            continue;
-        }
-        clearInputBuffer();
-        
-        switch (choice) {
-            case 1: recordTimeIn(); break;
-            case 2: recordAbsent(); break;
-                case 3: printf("\n\t\t\t\t                                        Returning to Admin Menu.\n"); break;
-                case 4: sortEmployeesByID(); break;
-            default: printf("\n\t\t\t\t                                        Invalid choice. Please select 1-4.\n");
-        }
-        if (choice != 3) pressEnterToContinue();
-    } while (choice != 3);
-}
+// ATTENDANCE PARTITION (an earlier month read for a report)
+typedef struct {
+    int month;              // months since 0000-01 (year * 12 + month - 1)
+    int count;
+    ChunkedStore store;
+} AttendancePartition;
 
-// Records a time-in entry for an employee with current date and time
-void recordTimeIn(void) {
-    system(CLEAR_COMMAND);
-    printf("\n\t\t\t\t                                        EMPLOYEE TIME IN\n");
-    
-    if (employeeCount == 0) {
-        printf("\t\t\t\t                                      No employees registered in the system.\n");
-        return;
-    }
-    
-    int empID;
-    printf("\t\t\t\t                             Enter Employee ID: ");
-    if (scanf("%d", &empID) != 1) {
-        printf("\t\t\t\t                                        Invalid ID format. Please enter numbers only.\n");
-        clearInputBuffer();
-        return;
-    }
-    clearInputBuffer();
-    
-    if (empID < 1000000 || empID > 9999999) {
-        printf("\t\t\t\t                     Employee ID. Must be 7 digits (1000000-9999999).\n");
-        return;
-    }
-    
-    int empIndex = findEmployeeIndexByID(empID);
-    
-    if (empIndex == -1) {
-        printf("\t\t\t\t                                 Employee ID not found. Please check your ID and try again.\n");
-        return;
-    }
-    
-    char currentDate[11], currentTime[6];
-    getCurrentDateTime(currentDate, currentTime);
-    
-    for (int i = 0; i < attendanceCount; i++) {
-        if (attendanceRecords[i].empID == empID && 
-            strcmp(attendanceRecords[i].date, currentDate) == 0) {
-            printf("\t\t\t\t                                 You have already timed in today at %s.\n", attendanceRecords[i].timeIn);
-            return;
-        }
-    }
-    
-    // Create new attendance record
-    if (attendanceCount < MAX_ATTENDANCE_RECORDS) {
-        AttendanceRecord newRecord = {0};
-        newRecord.empID = empID;
-        strcpy(newRecord.date, currentDate);
-        strcpy(newRecord.timeIn, currentTime);
-        newRecord.hoursWorked = 8.0f;
-        strcpy(newRecord.status, "Present");
-        newRecord.isLate = 0;
-        
-        attendanceRecords[attendanceCount++] = newRecord;
-        saveAttendanceToFile();
-        
-        printf("\n\t\t\t\t                                  Time-In Recorded Successfully!\n");
-        printf("\t\t\t\t                                  Employee:      %s\n", employees[empIndex].name);
-        printf("\t\t\t\t                                  Date:          %s\n", currentDate);
-        printf("\t\t\t\t                                  Time-In:       %s\n", currentTime);
-        printf("\t\t\t\t                                  Status:        %s\n", newRecord.status);
-    } else {
-        printf("\t\t\t\t                     Attendance records limit reached. Cannot record time-in.\n");
-    }
-}
 
-// Records an absent entry for an employee
-void recordAbsent(void) {
-    system(CLEAR_COMMAND);
-    printf("\n\t\t\t\t                                        RECORD ABSENT\n");
-    
-    if (employeeCount == 0) {
-        printf("\t\t\t\t                           No employees registered in the system.\n");
-        return;
-    }
-    
-    int empID;
-    printf("\t\t\t\t                             Enter Employee ID: ");
-    if (scanf("%d", &empID) != 1) {
-        printf("\t\t\t\t                       Invalid ID format. Please enter numbers only.\n");
-        clearInputBuffer();
-        return;
-    }
-    clearInputBuffer();
-    
-    if (empID < 1000000 || empID > 9999999) {
-        printf("\t\t\t\t                Invalid Employee ID. Must be 7 digits (1000000-9999999).\n");
-        return;
-    }
-    
-    int empIndex = findEmployeeIndexByID(empID);
-    
-    if (empIndex == -1) {
-        printf("\t\t\t\t\tEmployee ID not found. Please check your ID and try again.\n");
-        return;
-    }
-    
-    char currentDate[11], currentTime[6];
-    getCurrentDateTime(currentDate, currentTime);
-    
-    for (int i = 0; i < attendanceCount; i++) {
-        if (attendanceRecords[i].empID == empID && 
-            strcmp(attendanceRecords[i].date, currentDate) == 0) {
-            printf("\t\t\t\t\tAttendance for this employee has already been recorded for today.\n");
-            return;
-        }
-    }
-    
-    // Create new absent record
-    if (attendanceCount < MAX_ATTENDANCE_RECORDS) {
-        AttendanceRecord newRecord = {0};
-        newRecord.empID = empID;
-        strcpy(newRecord.date, currentDate);
-        strcpy(newRecord.timeIn, "00:00");
-        newRecord.hoursWorked = 0.0f;
-        strcpy(newRecord.status, "Absent");
-        newRecord.isLate = 0;
-        newRecord.overtimeHours = 0.0f;
-        
-        attendanceRecords[attendanceCount++] = newRecord;
-        saveAttendanceToFile();
-        
-        printf("\n\t\t\t\t\tAbsent Recorded Successfully!\n");
-        printf("\t\t\t\t\tEmployee:  %s\n", employees[empIndex].name);
-        printf("\t\t\t\t\tDate:      %s\n", currentDate);
-        printf("\t\t\t\t\tStatus:    Absent\n");
-    } else {
-        printf("\t\t\t\t\tAttendance records limit reached. Cannot record absent.\n");
-    }
-}
 
 
 
 
 
 
+// BINARY SNAPSHOT FORMAT
+// A 64-byte header followed by the records exactly as they are laid out in memory, so a
+// snapshot is loaded by mapping the file and copying whole chunks without any parsing.
+// SNAPSHOT_VERSION must be bumped whenever Employee or AttendanceRecord changes.
+#define SNAPSHOT_MAGIC "ERSSNAP"
+#define SNAPSHOT_VERSION 4
+#define SNAPSHOT_KIND_EMPLOYEES 1
+#define SNAPSHOT_KIND_ATTENDANCE 2
 
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int kind;
+    unsigned int recordSize;
+    unsigned int nextID;        // employee snapshots: the ID allocator's cursor (0 in older files)
+    unsigned long long recordCount;
+    unsigned long long generation;
+    unsigned long long checksum;
+    unsigned char reserved[16];
+} SnapshotHeader;
+
+_Static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader should stay 64 bytes");
 
-// Displays attendance summary for all employees with days worked and absent information
-void viewAttendance(void) {
-    system(CLEAR_COMMAND);
-    printf("\n\t\t\t               EMPLOYEE ATTENDANCE\n");
-    
-    if (employeeCount == 0) {
-        printf("\t\t\t               No employees registered in the system.\n");
-        return;
-    }
-    
-    int daysAbsentArray[MAX_EMPLOYEES] = {0};
-    int hasAbsences = 0;
+typedef struct {
+    unsigned char *data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} MappedFile;
 
-    for (int i = 0; i < employeeCount; i++) {
-        int daysWorked = 0;
-        int daysAbsent = 0;
-        float totalOvertime = 0.0;
-        
-        for (int j = 0; j < attendanceCount; j++) {
-            if (attendanceRecords[j].empID == employees[i].empID) {
-                if (strcmp(attendanceRecords[j].status, "Present") == 0) {
-                    daysWorked++;
-                } else if (strcmp(attendanceRecords[j].status, "Absent") == 0) {
-                    daysAbsent++;
-                }
-                totalOvertime += attendanceRecords[j].overtimeHours;
-            }
-        }
-        
-        employees[i].daysWorked = daysWorked;
-        employees[i].totalOvertimeHours = totalOvertime;
-        
-        if (daysAbsent > 0) hasAbsences = 1;
-        daysAbsentArray[i] = daysAbsent;
-    }
-    
-    printf("\n\n\t\t\t               ========================================================================================\n");
-    printf("\t\t\t               | %-7s  %-35s  %-25s  %-10s  |\n", "ID", "Name", "Days Worked", "Absent");
-    printf("\t\t\t               ========================================================================================\n\n");
-    
-    for (int i = 0; i < employeeCount; i++) {
-        int daysWorked = employees[i].daysWorked;
-        int daysAbsent = daysAbsentArray[i];
-        
-        printf("\t\t\t                 %-7d  %-35s  %-25d  %-10d  \n\n",
-                employees[i].empID,
-                employees[i].name,
-                daysWorked,
-                daysAbsent);
-    }
-    printf("\t\t\t               ----------------------------------------------------------------------------------------\n");
-    
-    saveToFile();
-}
 
 
 
@@ -968,25 +642,25 @@ void viewAttendance(void) {
 
 
 
+// PENDING PAYROLL CHANGES
+// Ordered list of employee changes not yet persisted; upserts are written from the current
+// employee data at flush time, so an employee changed many times is written once
+typedef enum {
+    CHANGE_UPSERT,
+    CHANGE_REMOVE
+} ChangeType;
 
-// SALARY COMPUTATION 
+typedef struct {
+    int empID;
+    ChangeType type;
+} PendingChange;
 
-// Calculates income tax based on Philippine 2024 tax brackets
-float calculateIncomeTax(float taxableIncome) {
-    if (taxableIncome <= TAX_TIER_1_LIMIT) {
-        return 0.00f;
-    } else if (taxableIncome <= TAX_TIER_2_LIMIT) {
-        return (taxableIncome - TAX_TIER_1_LIMIT) * TAX_RATE_TIER_2;
-    } else if (taxableIncome <= TAX_TIER_3_LIMIT) {
-        return TAX_BASE_TIER_3 + (taxableIncome - TAX_TIER_2_LIMIT) * TAX_RATE_TIER_3;
-    } else if (taxableIncome <= TAX_TIER_4_LIMIT) {
-        return TAX_BASE_TIER_4 + (taxableIncome - TAX_TIER_3_LIMIT) * TAX_RATE_TIER_4;
-    } else if (taxableIncome <= TAX_TIER_5_LIMIT) {
-        return TAX_BASE_TIER_5 + (taxableIncome - TAX_TIER_4_LIMIT) * TAX_RATE_TIER_5;
-    } else {
-        return TAX_BASE_TIER_6 + (taxableIncome - TAX_TIER_5_LIMIT) * TAX_RATE_TIER_6;
-    }
-}
+typedef struct {
+    PendingChange *changes;
+    int count;
+    int capacity;
+    time_t firstChangeTime;
+} PendingSaves;
 
 
 
@@ -995,189 +669,6953 @@ float calculateIncomeTax(float taxableIncome) {
 
 
 
-// Calculates and displays monthly salary computation for all employees
-void calculateAndDisplaySalary(void) {
-    system(CLEAR_COMMAND);
-    if (employeeCount == 0) {
-        printf("\n\t\t\t                                             No employees for salary computation.\n");
-        return;
-    }
+// ATTENDANCE PUNCH RESULT (shared by the menu prompts and the kiosk server)
+typedef enum {
+    PUNCH_OK,
+    PUNCH_INVALID_ID,
+    PUNCH_NOT_FOUND,
+    PUNCH_ALREADY_RECORDED,
+    PUNCH_NO_MEMORY
+} PunchResult;
 
-    printf("\n\t\t\t                            Monthly Salary Computation (Attendance Based)\n");
-    printf("\t\t\t                                 (Based on %d Standard Working Days)\n\n", STANDARD_WORKING_DAYS);
 
-    printf("\t\t                 ==================================================================================================\n");
-    printf("\t\t                 | %-7s %-20s    %-5s   %-10s   %-11s   %-10s   %-11s   |\n",  "ID", "Name", "Days", "Daily Rate", "Basic Salary", "Deductions", "Net Salary");
-    printf("\t\t                 ==================================================================================================\n");
 
-    for (int i = 0; i < employeeCount; i++) {
-        // Calculate rates
-        float dailyRate = employees[i].monthlySalary / STANDARD_WORKING_DAYS;
-        float hourlyRate = dailyRate / 8.0f;
 
-        // Calculate Basic Pay (only for days actually worked)
-        float basicSalary = dailyRate * employees[i].daysWorked;
-        if (basicSalary < 0.0f) basicSalary = 0.0f;
-        
-        float absentDeduct = 0.0f;
-        if (employees[i].daysWorked < STANDARD_WORKING_DAYS) {
-            absentDeduct = (STANDARD_WORKING_DAYS - employees[i].daysWorked) * dailyRate;
-        }
-
-        // Overtime removed
-        float overtimePay = 0.0f;
-        // Calculate Gross Pay without overtime (absent deduction already reflected in lower basicSalary)
-        float grossPay = basicSalary;
-        if (grossPay < 0.0f) grossPay = 0.0f;
-
-        // Calculate mandatory deductions (only if grossPay is positive)
-        float sssDeduct = 0.0f;
-        float philhealthDeduct = 0.0f;
-        float pagibigDeduct = 0.0f;
-        float incomeTaxDeduct = 0.0f;
-        
-        if (grossPay > 0.0f) {
-            sssDeduct = grossPay * DEDUCTION_SSS_RATE;
-            philhealthDeduct = grossPay * DEDUCTION_PHILHEALTH_RATE;
-            pagibigDeduct = grossPay * DEDUCTION_PAGIBIG_RATE;
-            
-            // Calculate taxable income
-            float taxableIncome = grossPay;
-            
-            // Calculate Income Tax
-            incomeTaxDeduct = calculateIncomeTax(taxableIncome);
-        }
-
-        // Final calculation
-        float totalDeduction = sssDeduct + philhealthDeduct + pagibigDeduct + incomeTaxDeduct;
-        float netSalary = grossPay - totalDeduction;
-        if (netSalary < 0.0f) netSalary = 0.0f;
-
-        // Store calculation results
-        employees[i].lastDailyRate = dailyRate;
-        employees[i].lastAbsentDeduct = absentDeduct;
-        employees[i].lastOvertimePay = 0.0f;
-        employees[i].lastGrossPay = grossPay;
-        employees[i].lastNetPay = netSalary;
-        employees[i].lastSSS = sssDeduct;
-        employees[i].lastPhilHealth = philhealthDeduct;
-        employees[i].lastPagIBIG = pagibigDeduct;
-        employees[i].lastIncomeTax = incomeTaxDeduct;
 
-        printf("\n\t\t                 %-7d   %-20s    %-5d   %-10.2f   %-11.2f    %-10.2f   %-11.2f \n\n",
-                employees[i].empID, 
-                employees[i].name, 
-                employees[i].daysWorked,
-                dailyRate,
-                basicSalary, 
-                totalDeduction,
-                netSalary);
-    }
-    printf("\t\t                 --------------------------------------------------------------------------------------------------\n");
-    saveToFile();
-    printf("\n\t\t\t                                  All monthly salary computations completed and saved.\n");
-}
 
 
 
+// KIOSK PUNCH QUEUE
+// Intrusive multi-producer single-consumer queue: client threads push with one atomic
+// exchange and never block each other; only the main thread pops and touches the stores.
+// An event lives on its client thread's stack until the main thread raises its signal; the
+// client sleeps on the signal meanwhile rather than polling.
+typedef struct PunchEvent {
+    _Atomic(struct PunchEvent *) next;
+    int empID;
+    AttendanceStatus status;
+    int day;                // the day a recorded punch was added for
+    WorkerSignal *done;     // the client thread's signal, raised once reply is set
+    char reply[128];
+} PunchEvent;
 
+typedef struct {
+    _Atomic(PunchEvent *) head;     // producers push here
+    PunchEvent *tail;               // consumer pops here
+    PunchEvent stub;
+} PunchQueue;
 
 
 
 
-// Displays a detailed salary slip for a specific employee
-void displayEmployeeSalarySlip(int id) {
-    system(CLEAR_COMMAND);
-    int idx = findEmployeeIndexByID(id);
 
-    if (idx == -1) {
-        printf("\n\t\t\t\t                                         Employee with ID %d not found.\n", id);
-        return;
-    }
-    
-    if (employees[idx].lastGrossPay == 0.0f && employees[idx].daysWorked == 0) {
-        printf("\n\t\t\t\t                              Salary computation has not been run for this employee yet.\n");
-        printf("\t\t\t\t                             Please run 'Calculate & View Monthly Salary Computation' first.\n");
-        return;
-    }
 
-    printf("\n\t\t\t\t                          ==========================================\n");
-    printf("\t\t\t\t                                   GENERATING SALARY SLIP\n");
-    printf("\t\t\t\t                          ==========================================\n\n");
-    fflush(stdout);
-    
-    // Animated processing similar to Kali Linux install process
-    const char* stages[] = {
-        "processing",
-        "record system initializing",
-        "computation starting",
-        "deduction calculating"
-    };
-    int numStages = 4;
-    int stageDuration = 750; // 750ms per stage = 3 seconds total
-    
-    for (int stage = 0; stage < numStages; stage++) {
-        printf("\t\t\t\t                          [%d/%d] %s", stage + 1, numStages, stages[stage]);
-        fflush(stdout);
-        
-        // Animate dots
-        for (int dot = 0; dot < 15; dot++) {
-            printf(".");
-            fflush(stdout);
-            SLEEP_FUNCTION(stageDuration / 15);
-        }
-        
-        printf(" [OK]\n");
-        fflush(stdout);
-    }
-    
-    printf("\n\t\t\t\t                          ==========================================\n");
-    printf("\t\t\t\t                            Salary Slip Generated Successfully!\n");
-    printf("\t\t\t\t                          ==========================================\n\n");
-    SLEEP_FUNCTION(500);
+
+
+// CSV READER
+// Reads a CSV file CSV_CHUNK_SIZE bytes at a time and splits each row inside its buffer:
+// fields point into the buffer (a quoted field is unquoted by shifting its own bytes), so
+// rows are never copied and memory use does not grow with the file.
+typedef struct {
+    FILE *fp;
+    char *buffer;           // CSV_CHUNK_SIZE bytes plus a terminator
+    size_t start;           // first byte not yet returned as part of a row
+    size_t end;             // end of the bytes read so far
+    int eof;
+    int lineNo;             // line the last row returned started on
+    int nextLine;
+} CsvReader;
+
+
+
+
+
+
+
+
+// BENCHMARK RUN
+// One dataset being measured; the active month's attendance is in the attendance store and
+// the months before it are only on disk
+typedef struct {
+    FILE *out;                  // BENCHMARK_OUTPUT_FILE
+    char started[20];           // when the run began (YYYY-MM-DDTHH:MM:SS), shared by its lines
+    int employees;
+    int months;                 // the active month plus months - 1 earlier ones
+    int attendance;             // records in the active month
+    long long history;          // records in the earlier months
+    int *lookupIDs;             // BENCHMARK_LOOKUPS IDs, alternately present and absent
+} BenchmarkRun;
+
+// A measured step: does its untimed setup, then returns the milliseconds its timed part took
+// (negative if it failed) and sets *items to the number of things it processed
+typedef double (*BenchmarkStep)(BenchmarkRun *run, long long *items);
+
+
+
+
+
+
+
+
+// EMPLOYEE ID ALLOCATOR
+// One bit per ID in [MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID] marking the IDs in use, and a cursor
+// that only moves forward (wrapping at the end of the range). New IDs are the first free bits
+// from the cursor, so IDs are handed out in order, a full word of taken IDs is skipped at
+// once, and a removed employee's ID is not given out again until the cursor comes round.
+// The bitmap is rebuilt from the employees on load; only the cursor is saved.
+typedef struct {
+    unsigned long long *used;
+    int usedCount;
+    int next;           // next ID to try
+    int savedNext;      // next as last written to the payroll file or journal
+} EmployeeIDAllocator;
+
+
+
+
+
+
+
+
+// EMPLOYEE NAME INDEX
+// Every employee's name folded to lower case (kept per slot in employeeNameKeys) and an
+// open-addressing hash table (linear probing) from folded name to slot, so duplicate-name
+// checks look up one bucket run instead of comparing against every employee.
+// A slot of -1 marks an empty bucket; capacity is a power of two.
+typedef struct {
+    char folded[50];
+} EmployeeNameKey;
+
+typedef struct {
+    unsigned int hash;
+    int slot;
+} NameIndexEntry;
+
+typedef struct {
+    NameIndexEntry *entries;
+    int capacity;
+    int used;
+} EmployeeNameIndex;
+
+
+
+
+
+
+
+
+// EMPLOYEE SORT INDEXES
+// For each listing order, every employee slot sorted by that order's key (ties broken by ID).
+// They are kept in order on add, update, remove and payroll runs, so listing employees in
+// any order walks an index and the records themselves never move.
+typedef enum {
+    EMPLOYEE_ORDER_ID,
+    EMPLOYEE_ORDER_NAME,
+    EMPLOYEE_ORDER_POSITION,
+    EMPLOYEE_ORDER_NET_PAY,     // highest first
+    NUM_EMPLOYEE_ORDERS
+} EmployeeOrder;
+
+const char *EmployeeOrderNames[NUM_EMPLOYEE_ORDERS] = {
+    "ID",
+    "Name",
+    "Position",
+    "Net Pay"
+};
+
+typedef struct {
+    int *slots;
+    int count;
+    int capacity;
+} EmployeeSortIndex;
+
+
+
+
+
+
+
+
+// EMPLOYEE ID INDEX
+// Open-addressing hash table (linear probing) mapping an empID to its slot in the
+// employee store. An empID of 0 marks an empty bucket; capacity is a power of two.
+typedef struct {
+    int empID;
+    int slot;
+} IDIndexEntry;
+
+typedef struct {
+    IDIndexEntry *entries;
+    int capacity;
+    int shift;      // 32 - log2(capacity): hashEmployeeID keeps the top log2(capacity) bits
+    int used;
+} EmployeeIDIndex;
+
+
+
+
+
+
+
+
+// ATTENDANCE DAY INDEX
+// Open-addressing hash table keyed by (empID, day number) pointing at the attendance
+// record for that day, so duplicate punches are detected without scanning the log.
+typedef struct {
+    int empID;
+    int day;
+    int record;
+} DayIndexEntry;
+
+typedef struct {
+    DayIndexEntry *entries;
+    int capacity;
+    int used;
+} AttendanceDayIndex;
+
+
+
+
+
+
+
+
+// ATTENDANCE ORDER INDEX
+// Record numbers of the active month sorted by (day, empID), so a pay period is one
+// contiguous run found by binary search instead of a scan of the whole log. Punches for
+// today append at the end; only back-dated imports shift entries.
+typedef struct {
+    int *records;
+    int count;
+    int capacity;
+} AttendanceOrderIndex;
+
+
+
+
+
+
+
+
+// GLOBAL STORAGE
+ChunkedStore employeeStore = { NULL, 0, 0, EMPLOYEE_CHUNK_SHIFT, sizeof(Employee) };
+int employeeCount = 0;
+EmployeeIDIndex employeeIDIndex = { NULL, 0, 0, 0 };
+EmployeeIDAllocator employeeIDAllocator = { NULL, 0, MIN_EMPLOYEE_ID, MIN_EMPLOYEE_ID };
+ChunkedStore employeeNameKeys = { NULL, 0, 0, EMPLOYEE_CHUNK_SHIFT, sizeof(EmployeeNameKey) };
+EmployeeNameIndex employeeNameIndex = { NULL, 0, 0 };
+EmployeeSortIndex employeeSortIndexes[NUM_EMPLOYEE_ORDERS];
+EmployeeOrder employeeListOrder = EMPLOYEE_ORDER_ID;
+
+ChunkedStore attendanceStore = { NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+int attendanceCount = 0;
+AttendanceDayIndex attendanceDayIndex = { NULL, 0, 0 };
+AttendanceOrderIndex attendanceOrderIndex = { NULL, 0, 0 };
+int attendanceJournalCount = 0;
+
+// attendanceStore holds the month activePartitionMonth; earlier months read for reports are
+// cached in partitionCache (replaced round-robin once full)
+int activePartitionMonth = -1;
+AttendancePartition partitionCache[PARTITION_CACHE_SIZE];
+int partitionCacheCount = 0;
+int partitionCacheNext = 0;
+
+// Attendance records [0, attendanceFoldedCount) are already counted in the employees' totals;
+// -1 means the totals must be rebuilt from the whole log (after loading or removing an employee).
+// The totals cover the pay period starting on foldedPeriodFirstDay.
+int attendanceFoldedCount = -1;
+int foldedPeriodFirstDay = -1;
+int foldedPeriodLastDay = -1;
+int useBinarySnapshots = 0;
+
+// Every successful save bumps its generation; the attendance journal records the
+// generation of the snapshot it extends so a stale journal is never replayed twice
+unsigned long long payrollGeneration = 0;
+unsigned long long attendanceGeneration = 0;
+
+PendingSaves pendingSaves = { NULL, 0, 0, 0 };
+
+// Kiosk server state (see serveKiosk)
+PunchQueue punchQueue;
+WorkerSignal punchQueueSignal;      // raised by clients after each push and by SHUTDOWN
+atomic_int kioskStopRequested = 0;
+atomic_int kioskClients = 0;
+atomic_llong kioskAckCount = 0;
+atomic_llong kioskAckMicros = 0;
+atomic_llong kioskAckMaxMicros = 0;
+
+// Group commit policy and counters (commitsBySize buckets: 1, 2-4, 5-16, 17-64, 65+ punches)
+int groupCommitBatch = GROUP_COMMIT_DEFAULT_BATCH;
+int groupCommitDelayMs = GROUP_COMMIT_DEFAULT_DELAY_MS;
+atomic_llong journalCommits = 0;
+atomic_llong journalCommittedPunches = 0;
+atomic_llong journalLargestCommit = 0;
+atomic_llong journalCommitsBySize[GROUP_COMMIT_BUCKETS];
+
+// Quiet mode skips screen clears and animations; set from SETTINGS_FILE, then the
+// QUIET_ENV_VAR environment variable, then the --quiet flag (each overriding the last)
+int quietMode = 0;
+// Set while running a batch command: loading and saving messages then go to stderr so they
+// never mix with a command's output on stdout
+int batchMode = 0;
+// Set for commands that only read the data (the exports and reports): loading then leaves
+// every file as it is, so no migration, journal reset or save happens
+int readOnlyMode = 0;
+
+// Pay period policy (pay_period= and period_cutoff= in SETTINGS_FILE)
+PayPeriodType payPeriodType = PAY_PERIOD_MONTHLY;
+int payPeriodCutoff = DEFAULT_PAY_PERIOD_CUTOFF;
+int payrollJournalCount = 0;
+
+
+
+
+
+
+
+// Function Prototype
+
+// Storage Functions
+int storeReserve(ChunkedStore *store, int count);
+void *storeAt(const ChunkedStore *store, int index);
+void storeFree(ChunkedStore *store);
+Employee *employeeAt(int index);
+AttendanceRecord *attendanceAt(int index);
+
+// Employee ID Index Functions
+unsigned int hashEmployeeID(int id, int shift);
+int idIndexResize(int capacity);
+void idIndexPut(int id, int slot);
+void idIndexRemove(int id);
+int idIndexGet(int id);
+void rebuildEmployeeIDIndex(void);
+void freeEmployeeIDIndex(void);
+
+// Employee ID Allocator Functions
+void setNextEmployeeID(int id);
+void markEmployeeIDUsed(int id);
+int allocateEmployeeIDs(int count, int *ids);
+void returnEmployeeID(int id);
+void releaseEmployeeID(int id);
+void rebuildEmployeeIDAllocator(void);
+void freeEmployeeIDAllocator(void);
+
+// Employee Name Index Functions
+void foldName(const char *name, char *folded, size_t size);
+unsigned int hashFoldedName(const char *folded);
+const char *employeeNameKey(int slot);
+int nameIndexResize(int capacity);
+void nameIndexPut(int slot);
+int nameIndexBucket(int slot);
+void nameIndexRemove(int slot);
+void nameIndexMove(int from, int to);
+int nameIndexFind(const char *name, int excludeID);
+void rebuildEmployeeNameIndex(void);
+void freeEmployeeNameIndex(void);
+
+// Employee Sort Index Functions
+int compareEmployeeSlots(EmployeeOrder order, int a, int b);
+int compareSortIndexSlots(const void *a, const void *b);
+int employeeIndexesReserve(int capacity);
+int employeeIndexFind(EmployeeOrder order, int slot);
+void employeeIndexInsert(EmployeeOrder order, int slot);
+void employeeIndexRemove(EmployeeOrder order, int slot);
+void addToEmployeeIndexes(int slot);
+void removeFromEmployeeIndexes(int slot);
+void renumberInEmployeeIndexes(int from, int to);
+void updateEmployeeRecord(int slot, const Employee *updated);
+void rebuildEmployeeIndex(EmployeeOrder order);
+void rebuildEmployeeIndexes(void);
+void freeEmployeeIndexes(void);
+int findEmployeesByNamePrefix(const char *prefix, int *first);
+
+// Attendance Day Index Functions
+unsigned int hashEmployeeDay(int id, int day, int capacity);
+int dayIndexResize(int capacity);
+int dayIndexPut(int id, int day, int record);
+int dayIndexGet(int id, int day);
+void rebuildAttendanceDayIndex(void);
+void freeAttendanceDayIndex(void);
+int appendAttendanceRecord(const AttendanceRecord *record);
+void removeClearedAttendanceRecords(void);
+
+// Attendance Order Index Functions
+int compareRecordOrder(const void *a, const void *b);
+int orderIndexReserve(int capacity);
+void orderIndexInsert(int record);
+int orderIndexLowerBound(int day);
+void rebuildAttendanceOrderIndex(void);
+void freeAttendanceOrderIndex(void);
+
+// Utility Functions
+void clearScreen(void);
+void pauseMs(int ms);
+void printStatus(const char *fmt, ...);
+double wallClockMs(void);
+void loadSettings(void);
+int saveSettings(void);
+void clearInputBuffer(void);
+void pressEnterToContinue(void);
+int getIntInput(const char *prompt, int min, int max);
+void trimInput(char *text);
+const char *validateTextInput(const char *text, int letters_spaces_only);
+void getStringInput(const char *prompt, char *out, int maxlen, int letters_spaces_only);
+void getCurrentDateTime(char *date, char *timeBuf);
+int dateToDayNumber(const char *date);
+void formatDayNumber(int day, char *date);
+void civilFromDays(int day, int *year, int *month, int *dayOfMonth);
+int daysFromCivil(int year, int month, int dayOfMonth);
+int parseTimeOfDay(const char *timeBuf);
+void formatTimeOfDay(int minutes, char *timeBuf);
+unsigned short hoursToHundredths(float hours);
+AttendanceStatus getAttendanceStatusByName(const char *name);
+Money moneyFromPesos(double pesos);
+Money applyRate(Money amount, int basisPoints);
+
+// Employee Management
+int isValidEmployeeID(int id);
+int storeNewEmployee(const Employee *e);
+int generateEmployeeID(void);
+int findEmployeeIndexByID(int id);
+int findEmployeeIndexByName(const char *name);
+int isNameDuplicate(const char *name, int excludeID);
+PositionType getPositionTypeByName(const char *name);
+int strcasecmp(const char *s1, const char *s2);
+
+// File Operations
+void saveToFile(void);
+void loadFromFile(void);
+void loadPayrollSnapshot(void);
+int saveAttendanceToFile(void);
+void loadAttendanceFromFile(void);
+FILE *beginAtomicWrite(const char *path, char *tmpPath, size_t tmpSize, const char *mode);
+int fileExists(const char *path);
+int commitAtomicWrite(FILE *fp, const char *tmpPath, const char *path);
+int writeEmployeeText(const char *path, unsigned long long generation);
+int writeAttendanceText(const char *path, const ChunkedStore *store, int count, unsigned long long generation);
+int readAttendanceText(const char *path, ChunkedStore *store, int *count, unsigned long long *generation);
+void resetAttendanceJournal(void);
+int parseAttendanceRecord(AttendanceRecord *r, int empID, const char *date, const char *timeBuf,
+                          float hoursWorked, const char *status, int isLate, float overtimeHours);
+void journalAttendanceRecord(const AttendanceRecord *r);
+size_t formatJournalLine(const AttendanceRecord *r, char *line, size_t size);
+int commitAttendanceJournal(const char *lines, size_t len, int count);
+int replayAttendanceJournal(void);
+void compactAttendanceJournal(void);
+int parseAttendanceLine(const char *line, AttendanceRecord *r);
+void appendFormat(char *buf, size_t size, size_t *len, const char *fmt, ...);
+size_t renderPaySlip(const Employee *e, char *buf, size_t size);
+int writePaySlipFile(const Employee *e, const char *dir, char *filename, size_t filenameSize);
+void printPaySlipToFile(const Employee *e);
+WORKER_RETURN payslipWorker(void *arg);
+int exportAllPayslips(const char *dir, const char *archivePath, int *written);
+void bulkPayslipMenu(void);
+
+// Attendance Partition Functions
+int monthOfDay(int day);
+int currentPartitionMonth(void);
+void formatPartitionMonth(int month, char *text);
+int parsePartitionMonth(const char *text);
+void partitionPath(int month, int binary, char *path, size_t size);
+int partitionMonthOfFile(const char *name);
+int comparePartitionMonths(const void *a, const void *b);
+int listAttendancePartitions(int **months);
+int loadAttendancePartition(int month, ChunkedStore *store, int *count, unsigned long long *generation);
+int writeAttendancePartition(int month, const ChunkedStore *store, int count, unsigned long long generation);
+int openAttendancePartition(int month);
+int switchAttendancePartition(int month);
+int attendanceJournalMonth(void);
+int compareAttendanceRecords(const void *a, const void *b);
+int mergeAttendancePartition(int month, AttendanceRecord *records, int count, int *duplicates);
+int purgeEmployeeAttendance(int empID);
+void migrateLegacyAttendance(void);
+int attendanceForMonth(int month, const ChunkedStore **store, int *count);
+void dropCachedPartition(int month);
+void freePartitionCache(void);
+
+// Pay Period Functions
+void payPeriodContaining(int day, int *firstDay, int *lastDay);
+void currentPayPeriod(int *firstDay, int *lastDay);
+int payPeriodsPerMonth(void);
+void formatPayPeriod(int firstDay, int lastDay, char *text);
+int activatePartitionFor(int day);
+void setPayPeriodType(PayPeriodType type);
+
+// Write-Behind Functions
+void recordPendingChange(int empID, ChangeType type);
+void markEmployeeDirty(int slot);
+void markEmployeeRemoved(int empID);
+void clearPendingSaves(void);
+void writeEmployeeJournalLine(FILE *fp, const Employee *e);
+int appendPayrollJournal(void);
+int replayPayrollJournal(void);
+void resetPayrollJournal(void);
+void flushPendingSaves(int force);
+
+// Binary Snapshot Functions
+int mapFile(const char *path, MappedFile *map);
+void unmapFile(MappedFile *map);
+unsigned long long snapshotChecksum(unsigned long long hash, const void *data, size_t size);
+int writeSnapshot(const char *path, unsigned int kind, const ChunkedStore *store, int count,
+                  unsigned long long generation);
+int loadSnapshot(const char *path, unsigned int kind, ChunkedStore *store, int *count,
+                 unsigned long long *generation);
+void exportBinarySnapshots(void);
+void exportTextFiles(void);
+void dataFilesMenu(void);
+
+// Menu Functions
+void mainMenu(void);
+void adminMenu(void);
+int verifyPin(void);
+
+// Employee Operations
+void viewEmployees(EmployeeOrder order);
+void addEmployee(void);
+void updateEmployee(void);
+void removeEmployee(void);
+void setEmployeeListOrder(EmployeeOrder order);
+void searchEmployeesByName(void);
+
+// Salary Functions
+void calculateAndDisplaySalary(void);
+Money calculateIncomeTax(Money taxableIncome);
+void computePayroll(Money monthlySalary, Money daysWorked, int periodsPerMonth, PayrollResult *out);
+void applyPayrollResult(int slot, const PayrollResult *p);
+int countProcessors(void);
+int startWorker(WorkerThread *thread, WORKER_RETURN (*fn)(void *), void *arg);
+void joinWorker(WorkerThread thread);
+WORKER_RETURN payrollWorker(void *arg);
+int initPayrollColumns(PayrollColumns *cols, const int *slots, int count);
+void freePayrollColumns(PayrollColumns *cols);
+void payrollKernel(PayrollColumns *cols, int first, int last);
+void getPayrollColumnsRow(const PayrollColumns *cols, int i, PayrollResult *out);
+int computePayrollColumns(PayrollColumns *cols, const int *slots, int count);
+int recomputeStalePayroll(void);
+void displayEmployeeSalarySlip(int id);
+
+// Attendance Functions
+PunchResult punchAttendance(int empID, AttendanceStatus status, AttendanceRecord *out);
+void attendanceMenu(void);
+void recordTimeIn(void);
+void recordAbsent(void);
+void viewAttendance(void);
+void viewAttendanceHistory(void);
+void printAttendanceSummary(const AttendanceSummary *summaries);
+void summarizeAttendance(const ChunkedStore *store, int count, AttendanceSummary *totals);
+int aggregateAttendance(AttendanceSummary *summaries);
+int foldNewAttendance(void);
+void markPayrollInputChanged(int slot);
+
+// Kiosk Server Functions
+void punchQueueInit(PunchQueue *q);
+void punchQueuePush(PunchQueue *q, PunchEvent *e);
+PunchEvent *punchQueuePop(PunchQueue *q);
+void detachWorker(WorkerThread thread);
+int initWorkerSignal(WorkerSignal *signal);
+void raiseWorkerSignal(WorkerSignal *signal);
+void waitWorkerSignal(WorkerSignal *signal);
+int waitWorkerSignalFor(WorkerSignal *signal, int ms);
+void freeWorkerSignal(WorkerSignal *signal);
+void handleStopSignal(int sig);
+WORKER_RETURN kioskClientWorker(void *arg);
+WORKER_RETURN kioskAcceptWorker(void *arg);
+int processPunchEvent(PunchEvent *e, char *batch, size_t *batchLen);
+void withdrawPunches(PunchEvent **events, int count);
+void formatGroupCommitStats(char *buf, size_t size);
+int serveKiosk(int port);
+
+// CSV Functions
+int csvOpen(CsvReader *reader, const char *path);
+void csvClose(CsvReader *reader);
+int csvReadRow(CsvReader *reader, char **fields, int maxFields);
+void writeCsvField(FILE *fp, const char *text);
+int parseCsvNumber(const char *text, double min, double max, double *value);
+int mergeImportedAttendance(AttendanceRecord *records, int count, int *imported, int *duplicates);
+
+// Benchmark Functions
+unsigned int benchmarkRandom(unsigned long long *state);
+int weekdaysInMonth(int month);
+int generateBenchmarkEmployees(int count);
+int generateBenchmarkMonth(int month, ChunkedStore *store, int *count);
+void removeBenchmarkFiles(int months);
+void clearEmployeeData(void);
+void clearAttendanceData(void);
+double benchSaveEmployees(BenchmarkRun *run, long long *items);
+double benchSaveAttendance(BenchmarkRun *run, long long *items);
+double benchSaveHistory(BenchmarkRun *run, long long *items);
+double benchLoadEmployees(BenchmarkRun *run, long long *items);
+double benchLoadAttendance(BenchmarkRun *run, long long *items);
+double benchLoadHistory(BenchmarkRun *run, long long *items);
+double benchFindEmployee(BenchmarkRun *run, long long *items);
+double benchAggregateAttendance(BenchmarkRun *run, long long *items);
+double benchComputePayroll(BenchmarkRun *run, long long *items);
+double benchRenderPayslips(BenchmarkRun *run, long long *items);
+int runBenchmarkCase(BenchmarkRun *run, const char *name, const char *format, BenchmarkStep step);
+int benchmarkDataset(BenchmarkRun *run);
+int runBenchmark(int argc, char *argv[]);
+
+// Batch Mode Functions
+int runCommandLine(int argc, char *argv[]);
+int batchComputePayroll(void);
+int batchImportAttendance(const char *path);
+int batchImportEmployeesCsv(const char *path);
+int batchExportEmployeesCsv(const char *path);
+int batchImportAttendanceCsv(const char *path);
+int batchExportAttendanceCsv(const char *path, const char *monthText);
+int batchAttendanceReport(const char *monthText);
+int batchExportPayslips(const char *dir, const char *archivePath);
+void printUsage(const char *program);
+
+
+
+
+
+
+
+
+// Implementation
+
+// CHUNKED STORAGE
+
+// Makes sure the store has room for at least count records, allocating new chunks as needed
+// Returns 1 on success, 0 if memory could not be allocated
+int storeReserve(ChunkedStore *store, int count) {
+    if (count < 0) return 0;
+    int perChunk = 1 << store->chunkShift;
+    int needed = (int)(((long long)count + perChunk - 1) >> store->chunkShift);
+
+    if (needed > store->chunkCapacity) {
+        int newCapacity = store->chunkCapacity ? store->chunkCapacity : 16;
+        while (newCapacity < needed) newCapacity *= 2;
+        char **grown = realloc(store->chunks, (size_t)newCapacity * sizeof(char *));
+        if (!grown) return 0;
+        store->chunks = grown;
+        store->chunkCapacity = newCapacity;
+    }
+
+    while (store->chunkCount < needed) {
+        char *chunk = malloc((size_t)perChunk * store->recordSize);
+        if (!chunk) return 0;
+        store->chunks[store->chunkCount++] = chunk;
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Returns a pointer to the record at index (the caller must have reserved it)
+void *storeAt(const ChunkedStore *store, int index) {
+    int mask = (1 << store->chunkShift) - 1;
+    return store->chunks[index >> store->chunkShift] + (size_t)(index & mask) * store->recordSize;
+}
+
+
+
+
+
+
+
+
+// Releases every chunk owned by the store
+void storeFree(ChunkedStore *store) {
+    for (int i = 0; i < store->chunkCount; i++) {
+        free(store->chunks[i]);
+    }
+    free(store->chunks);
+    store->chunks = NULL;
+    store->chunkCount = 0;
+    store->chunkCapacity = 0;
+}
+
+
+
+
+
+
+
+
+// Returns the employee stored in the given slot
+Employee *employeeAt(int index) {
+    return (Employee *)storeAt(&employeeStore, index);
+}
+
+
+
+
+
+
+
+
+// Returns the attendance record stored in the given slot
+AttendanceRecord *attendanceAt(int index) {
+    return (AttendanceRecord *)storeAt(&attendanceStore, index);
+}
+
+
+
+
+
+
+
+
+// EMPLOYEE ID INDEX
+
+// Maps an employee ID to its home bucket (Fibonacci hashing: the top bits of the product mix
+// every bit of the ID, where the low bits would depend only on the ID's own low bits)
+// shift is 32 - log2(capacity), kept in the index next to its capacity
+unsigned int hashEmployeeID(int id, int shift) {
+    return ((unsigned int)id * 2654435769u) >> shift;
+}
+
+
+
+
+
+
+
+
+// Re-hashes every entry into a table of the given capacity
+// Returns 1 on success, 0 if memory could not be allocated
+int idIndexResize(int capacity) {
+    IDIndexEntry *entries = calloc((size_t)capacity, sizeof(IDIndexEntry));
+    if (!entries) return 0;
+    int shift = 32;
+    for (int c = capacity; c > 1; c >>= 1) shift--;
+
+    for (int i = 0; i < employeeIDIndex.capacity; i++) {
+        IDIndexEntry entry = employeeIDIndex.entries[i];
+        if (entry.empID == 0) continue;
+        unsigned int b = hashEmployeeID(entry.empID, shift);
+        while (entries[b].empID != 0) b = (b + 1) & (unsigned int)(capacity - 1);
+        entries[b] = entry;
+    }
+
+    free(employeeIDIndex.entries);
+    employeeIDIndex.entries = entries;
+    employeeIDIndex.capacity = capacity;
+    employeeIDIndex.shift = shift;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Inserts an ID into the index, or updates its slot if it is already present
+void idIndexPut(int id, int slot) {
+    if ((employeeIDIndex.used + 1) * 2 > employeeIDIndex.capacity) {
+        int capacity = employeeIDIndex.capacity ? employeeIDIndex.capacity * 2 : ID_INDEX_MIN_CAPACITY;
+        if (!idIndexResize(capacity)) {
+            printf("\t\t\t\t\tOut of memory while growing the employee ID index.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    unsigned int mask = (unsigned int)(employeeIDIndex.capacity - 1);
+    unsigned int b = hashEmployeeID(id, employeeIDIndex.shift);
+    while (employeeIDIndex.entries[b].empID != 0) {
+        if (employeeIDIndex.entries[b].empID == id) {
+            employeeIDIndex.entries[b].slot = slot;
+            return;
+        }
+        b = (b + 1) & mask;
+    }
+    employeeIDIndex.entries[b].empID = id;
+    employeeIDIndex.entries[b].slot = slot;
+    employeeIDIndex.used++;
+}
+
+
+
+
+
+
+
+
+// Removes an ID from the index, shifting later entries of the probe run back into the gap
+void idIndexRemove(int id) {
+    if (employeeIDIndex.capacity == 0) return;
+    unsigned int mask = (unsigned int)(employeeIDIndex.capacity - 1);
+    unsigned int b = hashEmployeeID(id, employeeIDIndex.shift);
+
+    while (employeeIDIndex.entries[b].empID != id) {
+        if (employeeIDIndex.entries[b].empID == 0) return;
+        b = (b + 1) & mask;
+    }
+
+    unsigned int hole = b;
+    unsigned int next = (hole + 1) & mask;
+    while (employeeIDIndex.entries[next].empID != 0) {
+        unsigned int home = hashEmployeeID(employeeIDIndex.entries[next].empID, employeeIDIndex.shift);
+        // Move the entry back only if its home bucket does not lie between the hole and it
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            employeeIDIndex.entries[hole] = employeeIDIndex.entries[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    employeeIDIndex.entries[hole].empID = 0;
+    employeeIDIndex.entries[hole].slot = 0;
+    employeeIDIndex.used--;
+}
+
+
+
+
+
+
+
+
+// Returns the store slot for an employee ID, or -1 if the ID is not indexed
+int idIndexGet(int id) {
+    if (employeeIDIndex.capacity == 0 || id == 0) return -1;
+    unsigned int mask = (unsigned int)(employeeIDIndex.capacity - 1);
+    unsigned int b = hashEmployeeID(id, employeeIDIndex.shift);
+    while (employeeIDIndex.entries[b].empID != 0) {
+        if (employeeIDIndex.entries[b].empID == id) return employeeIDIndex.entries[b].slot;
+        b = (b + 1) & mask;
+    }
+    return -1;
+}
+
+
+
+
+
+
+
+
+// Rebuilds the ID index from scratch after employees were loaded or reordered
+void rebuildEmployeeIDIndex(void) {
+    int capacity = ID_INDEX_MIN_CAPACITY;
+    while (capacity < employeeCount * 2) capacity *= 2;
+
+    freeEmployeeIDIndex();
+    if (!idIndexResize(capacity)) {
+        printStatus("\t\t\t\t\tOut of memory while building the employee ID index.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < employeeCount; i++) {
+        idIndexPut(employeeAt(i)->empID, i);
+    }
+}
+
+
+
+
+
+
+
+
+// Releases the ID index
+void freeEmployeeIDIndex(void) {
+    free(employeeIDIndex.entries);
+    employeeIDIndex.entries = NULL;
+    employeeIDIndex.capacity = 0;
+    employeeIDIndex.shift = 0;
+    employeeIDIndex.used = 0;
+}
+
+
+
+
+
+
+
+
+// EMPLOYEE ID ALLOCATOR
+
+// Moves the allocator's cursor to id (used when loading it; out-of-range values are ignored)
+void setNextEmployeeID(int id) {
+    if (id < MIN_EMPLOYEE_ID || id > MAX_EMPLOYEE_ID) return;
+    employeeIDAllocator.next = id;
+    employeeIDAllocator.savedNext = id;
+}
+
+
+
+
+
+
+
+
+// Marks an ID as taken (IDs outside the 7-digit range are ignored)
+void markEmployeeIDUsed(int id) {
+    if (!employeeIDAllocator.used || id < MIN_EMPLOYEE_ID || id > MAX_EMPLOYEE_ID) return;
+    int bit = id - MIN_EMPLOYEE_ID;
+    unsigned long long mask = 1ull << (bit & 63);
+    if (employeeIDAllocator.used[bit >> 6] & mask) return;
+    employeeIDAllocator.used[bit >> 6] |= mask;
+    employeeIDAllocator.usedCount++;
+}
+
+
+
+
+
+
+
+
+// Reserves up to count unused IDs into ids, in order from the cursor
+// Returns the number reserved, fewer than count only when the whole range is taken
+int allocateEmployeeIDs(int count, int *ids) {
+    EmployeeIDAllocator *a = &employeeIDAllocator;
+    if (!a->used) return 0;
+
+    int allocated = 0;
+    int bit = a->next - MIN_EMPLOYEE_ID;
+    while (allocated < count && a->usedCount < EMPLOYEE_ID_SPACE) {
+        if (bit >= EMPLOYEE_ID_SPACE) bit = 0;
+        unsigned long long word = a->used[bit >> 6];
+        if (word == ~0ull) {
+            // Every ID in this word is taken: skip to the next word
+            bit = (bit | 63) + 1;
+            continue;
+        }
+        unsigned long long mask = 1ull << (bit & 63);
+        if (!(word & mask)) {
+            a->used[bit >> 6] = word | mask;
+            a->usedCount++;
+            ids[allocated++] = MIN_EMPLOYEE_ID + bit;
+        }
+        bit++;
+    }
+    a->next = MIN_EMPLOYEE_ID + (bit >= EMPLOYEE_ID_SPACE ? 0 : bit);
+    return allocated;
+}
+
+
+
+
+
+
+
+
+// Gives back the most recent ID reserved when it was never used (an add was cancelled),
+// so the next add is offered the same ID
+void returnEmployeeID(int id) {
+    releaseEmployeeID(id);
+    if (employeeIDAllocator.next == id + 1 || (id == MAX_EMPLOYEE_ID && employeeIDAllocator.next == MIN_EMPLOYEE_ID)) {
+        employeeIDAllocator.next = id;
+    }
+}
+
+
+
+
+
+
+
+
+// Frees the ID of a removed employee (it is reused only after the cursor wraps around)
+void releaseEmployeeID(int id) {
+    if (!employeeIDAllocator.used || id < MIN_EMPLOYEE_ID || id > MAX_EMPLOYEE_ID) return;
+    int bit = id - MIN_EMPLOYEE_ID;
+    unsigned long long mask = 1ull << (bit & 63);
+    if (!(employeeIDAllocator.used[bit >> 6] & mask)) return;
+    employeeIDAllocator.used[bit >> 6] &= ~mask;
+    employeeIDAllocator.usedCount--;
+}
+
+
+
+
+
+
+
+
+// Rebuilds the bitmap of taken IDs after employees were loaded (the cursor is kept)
+void rebuildEmployeeIDAllocator(void) {
+    size_t words = (EMPLOYEE_ID_SPACE + 63) / 64;
+    if (!employeeIDAllocator.used) {
+        employeeIDAllocator.used = malloc(words * sizeof(unsigned long long));
+        if (!employeeIDAllocator.used) {
+            printStatus("\t\t\t\t\tOut of memory while building the employee ID allocator.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    memset(employeeIDAllocator.used, 0, words * sizeof(unsigned long long));
+    // Bits past the end of the range (if it is not a multiple of 64) count as taken
+    if (EMPLOYEE_ID_SPACE % 64) employeeIDAllocator.used[words - 1] = ~0ull << (EMPLOYEE_ID_SPACE % 64);
+    employeeIDAllocator.usedCount = 0;
+
+    for (int i = 0; i < employeeCount; i++) {
+        markEmployeeIDUsed(employeeAt(i)->empID);
+    }
+}
+
+
+
+
+
+
+
+
+// Releases the ID bitmap
+void freeEmployeeIDAllocator(void) {
+    free(employeeIDAllocator.used);
+    employeeIDAllocator.used = NULL;
+    employeeIDAllocator.usedCount = 0;
+}
+
+
+
+
+
+
+
+
+// EMPLOYEE NAME INDEX
+
+// Copies name into folded in lower case, the same folding strcasecmp compares with
+void foldName(const char *name, char *folded, size_t size) {
+    size_t i = 0;
+    for (; name[i] && i + 1 < size; i++) {
+        folded[i] = (char)tolower((unsigned char)name[i]);
+    }
+    folded[i] = '\0';
+}
+
+
+
+
+
+
+
+
+// Hashes a folded name (FNV-1a)
+unsigned int hashFoldedName(const char *folded) {
+    unsigned int hash = 2166136261u;
+    while (*folded) {
+        hash = (hash ^ (unsigned char)*folded++) * 16777619u;
+    }
+    return hash;
+}
+
+
+
+
+
+
+
+
+// Returns the folded name of the employee in slot
+const char *employeeNameKey(int slot) {
+    return ((const EmployeeNameKey *)storeAt(&employeeNameKeys, slot))->folded;
+}
+
+
+
+
+
+
+
+
+// Re-hashes every entry into a table of the given capacity
+// Returns 1 on success, 0 if memory could not be allocated
+int nameIndexResize(int capacity) {
+    NameIndexEntry *entries = malloc((size_t)capacity * sizeof(NameIndexEntry));
+    if (!entries) return 0;
+    for (int i = 0; i < capacity; i++) entries[i].slot = -1;
+
+    unsigned int mask = (unsigned int)(capacity - 1);
+    for (int i = 0; i < employeeNameIndex.capacity; i++) {
+        NameIndexEntry entry = employeeNameIndex.entries[i];
+        if (entry.slot == -1) continue;
+        unsigned int b = entry.hash & mask;
+        while (entries[b].slot != -1) b = (b + 1) & mask;
+        entries[b] = entry;
+    }
+
+    free(employeeNameIndex.entries);
+    employeeNameIndex.entries = entries;
+    employeeNameIndex.capacity = capacity;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Folds the name of the employee in slot and adds it to the index
+// (room for the slot's key must already be reserved in employeeNameKeys)
+void nameIndexPut(int slot) {
+    if ((employeeNameIndex.used + 1) * 2 > employeeNameIndex.capacity) {
+        int capacity = employeeNameIndex.capacity ? employeeNameIndex.capacity * 2 : ID_INDEX_MIN_CAPACITY;
+        if (!nameIndexResize(capacity)) {
+            printf("\t\t\t\t\tOut of memory while growing the employee name index.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    EmployeeNameKey *key = storeAt(&employeeNameKeys, slot);
+    foldName(employeeAt(slot)->name, key->folded, sizeof(key->folded));
+    unsigned int hash = hashFoldedName(key->folded);
+
+    unsigned int mask = (unsigned int)(employeeNameIndex.capacity - 1);
+    unsigned int b = hash & mask;
+    while (employeeNameIndex.entries[b].slot != -1) b = (b + 1) & mask;
+    employeeNameIndex.entries[b].hash = hash;
+    employeeNameIndex.entries[b].slot = slot;
+    employeeNameIndex.used++;
+}
+
+
+
+
+
+
+
+
+// Returns the bucket holding slot, or -1 if the slot is not indexed
+int nameIndexBucket(int slot) {
+    if (employeeNameIndex.capacity == 0) return -1;
+    unsigned int mask = (unsigned int)(employeeNameIndex.capacity - 1);
+    unsigned int b = hashFoldedName(employeeNameKey(slot)) & mask;
+    while (employeeNameIndex.entries[b].slot != -1) {
+        if (employeeNameIndex.entries[b].slot == slot) return (int)b;
+        b = (b + 1) & mask;
+    }
+    return -1;
+}
+
+
+
+
+
+
+
+
+// Removes the employee in slot from the index, shifting later entries of the probe run
+// back into the gap (the slot's key must still hold the name it was indexed with)
+void nameIndexRemove(int slot) {
+    int found = nameIndexBucket(slot);
+    if (found == -1) return;
+    unsigned int mask = (unsigned int)(employeeNameIndex.capacity - 1);
+
+    unsigned int hole = (unsigned int)found;
+    unsigned int next = (hole + 1) & mask;
+    while (employeeNameIndex.entries[next].slot != -1) {
+        unsigned int home = employeeNameIndex.entries[next].hash & mask;
+        // Move the entry back only if its home bucket does not lie between the hole and it
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            employeeNameIndex.entries[hole] = employeeNameIndex.entries[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    employeeNameIndex.entries[hole].slot = -1;
+    employeeNameIndex.used--;
+}
+
+
+
+
+
+
+
+
+// Points the index at slot to after the record in from was moved there
+void nameIndexMove(int from, int to) {
+    int found = nameIndexBucket(from);
+    *(EmployeeNameKey *)storeAt(&employeeNameKeys, to) = *(const EmployeeNameKey *)storeAt(&employeeNameKeys, from);
+    if (found != -1) employeeNameIndex.entries[found].slot = to;
+}
+
+
+
+
+
+
+
+
+// Returns the slot of an employee named name (case-insensitive) whose ID is not excludeID,
+// or -1 if there is none
+int nameIndexFind(const char *name, int excludeID) {
+    if (employeeNameIndex.capacity == 0) return -1;
+    char folded[sizeof(((EmployeeNameKey *)0)->folded)];
+    foldName(name, folded, sizeof(folded));
+    unsigned int hash = hashFoldedName(folded);
+
+    unsigned int mask = (unsigned int)(employeeNameIndex.capacity - 1);
+    unsigned int b = hash & mask;
+    while (employeeNameIndex.entries[b].slot != -1) {
+        int slot = employeeNameIndex.entries[b].slot;
+        if (employeeNameIndex.entries[b].hash == hash && strcmp(employeeNameKey(slot), folded) == 0
+            && employeeAt(slot)->empID != excludeID) {
+            return slot;
+        }
+        b = (b + 1) & mask;
+    }
+    return -1;
+}
+
+
+
+
+
+
+
+
+// Rebuilds the name index from scratch after employees were loaded
+void rebuildEmployeeNameIndex(void) {
+    int capacity = ID_INDEX_MIN_CAPACITY;
+    while (capacity < employeeCount * 2) capacity *= 2;
+
+    freeEmployeeNameIndex();
+    if (!storeReserve(&employeeNameKeys, employeeCount) || !nameIndexResize(capacity)) {
+        printStatus("\t\t\t\t\tOut of memory while building the employee name index.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < employeeCount; i++) {
+        nameIndexPut(i);
+    }
+}
+
+
+
+
+
+
+
+
+// Releases the name index (the folded names are kept for reuse)
+void freeEmployeeNameIndex(void) {
+    free(employeeNameIndex.entries);
+    employeeNameIndex.entries = NULL;
+    employeeNameIndex.capacity = 0;
+    employeeNameIndex.used = 0;
+}
+
+
+
+
+
+
+
+
+// EMPLOYEE SORT INDEXES
+
+// Orders two employee slots by the given listing order; ties fall back to the employee ID,
+// so two different employees never compare equal
+int compareEmployeeSlots(EmployeeOrder order, int a, int b) {
+    const Employee *x = employeeAt(a);
+    const Employee *y = employeeAt(b);
+    int result = 0;
+    switch (order) {
+        case EMPLOYEE_ORDER_NAME:
+            result = strcmp(employeeNameKey(a), employeeNameKey(b));
+            break;
+        case EMPLOYEE_ORDER_POSITION:
+            result = (x->position > y->position) - (x->position < y->position);
+            if (result == 0) result = strcmp(employeeNameKey(a), employeeNameKey(b));
+            break;
+        case EMPLOYEE_ORDER_NET_PAY:
+            result = (x->lastNetPay < y->lastNetPay) - (x->lastNetPay > y->lastNetPay);
+            break;
+        default:
+            break;
+    }
+    if (result != 0) return result;
+    return (x->empID > y->empID) - (x->empID < y->empID);
+}
+
+
+
+
+
+
+
+
+// The order compareSortIndexSlots sorts by (qsort has no context argument)
+EmployeeOrder sortIndexOrder = EMPLOYEE_ORDER_ID;
+
+// qsort adapter for compareEmployeeSlots using sortIndexOrder
+int compareSortIndexSlots(const void *a, const void *b) {
+    return compareEmployeeSlots(sortIndexOrder, *(const int *)a, *(const int *)b);
+}
+
+
+
+
+
+
+
+
+// Makes room for at least capacity slots in every sort index and in the folded names
+// Returns 1 on success, 0 if memory could not be allocated
+int employeeIndexesReserve(int capacity) {
+    if (!storeReserve(&employeeNameKeys, capacity)) return 0;
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        EmployeeSortIndex *index = &employeeSortIndexes[o];
+        if (capacity <= index->capacity) continue;
+        int grown = index->capacity ? index->capacity : ID_INDEX_MIN_CAPACITY;
+        while (grown < capacity) grown *= 2;
+        int *slots = realloc(index->slots, (size_t)grown * sizeof(int));
+        if (!slots) return 0;
+        index->slots = slots;
+        index->capacity = grown;
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Returns the position of slot in an index, or of the first entry sorting after it when the
+// slot is not indexed (binary search: the record must still hold the values it was indexed with)
+int employeeIndexFind(EmployeeOrder order, int slot) {
+    const EmployeeSortIndex *index = &employeeSortIndexes[order];
+    int low = 0, high = index->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (compareEmployeeSlots(order, index->slots[mid], slot) < 0) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+
+
+
+
+
+
+
+// Adds a slot to one sort index (room must already be reserved)
+void employeeIndexInsert(EmployeeOrder order, int slot) {
+    EmployeeSortIndex *index = &employeeSortIndexes[order];
+    int at = employeeIndexFind(order, slot);
+    memmove(index->slots + at + 1, index->slots + at, (size_t)(index->count - at) * sizeof(int));
+    index->slots[at] = slot;
+    index->count++;
+}
+
+
+
+
+
+
+
+
+// Removes a slot from one sort index
+void employeeIndexRemove(EmployeeOrder order, int slot) {
+    EmployeeSortIndex *index = &employeeSortIndexes[order];
+    int at = employeeIndexFind(order, slot);
+    if (at >= index->count || index->slots[at] != slot) return;
+    memmove(index->slots + at, index->slots + at + 1, (size_t)(index->count - at - 1) * sizeof(int));
+    index->count--;
+}
+
+
+
+
+
+
+
+
+// Adds a newly stored employee to the name index and every sort index
+// (room must already be reserved)
+void addToEmployeeIndexes(int slot) {
+    nameIndexPut(slot);
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        employeeIndexInsert((EmployeeOrder)o, slot);
+    }
+}
+
+
+
+
+
+
+
+
+// Removes an employee from every index before its record changes or is dropped
+void removeFromEmployeeIndexes(int slot) {
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        employeeIndexRemove((EmployeeOrder)o, slot);
+    }
+    nameIndexRemove(slot);
+}
+
+
+
+
+
+
+
+
+// Points the indexes at slot to after the record in from was moved there
+// (the record is unchanged, so its position in each index stays the same)
+void renumberInEmployeeIndexes(int from, int to) {
+    nameIndexMove(from, to);
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        EmployeeSortIndex *index = &employeeSortIndexes[o];
+        int at = employeeIndexFind((EmployeeOrder)o, from);
+        if (at < index->count && index->slots[at] == from) index->slots[at] = to;
+    }
+}
+
+
+
+
+
+
+
+
+// Replaces the record in slot, moving it to its new place in each index
+void updateEmployeeRecord(int slot, const Employee *updated) {
+    removeFromEmployeeIndexes(slot);
+    *employeeAt(slot) = *updated;
+    addToEmployeeIndexes(slot);
+}
+
+
+
+
+
+
+
+
+// Rebuilds one sort index from scratch (after loading, or after many records changed)
+void rebuildEmployeeIndex(EmployeeOrder order) {
+    EmployeeSortIndex *index = &employeeSortIndexes[order];
+    for (int i = 0; i < employeeCount; i++) {
+        index->slots[i] = i;
+    }
+    index->count = employeeCount;
+    sortIndexOrder = order;
+    qsort(index->slots, (size_t)employeeCount, sizeof(int), compareSortIndexSlots);
+}
+
+
+
+
+
+
+
+
+// Rebuilds the name index and every sort index after employees were loaded
+void rebuildEmployeeIndexes(void) {
+    rebuildEmployeeNameIndex();
+    if (!employeeIndexesReserve(employeeCount)) {
+        printStatus("\t\t\t\t\tOut of memory while building the employee sort indexes.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        rebuildEmployeeIndex((EmployeeOrder)o);
+    }
+}
+
+
+
+
+
+
+
+
+// Releases the name index, the folded names and the sort indexes
+void freeEmployeeIndexes(void) {
+    freeEmployeeNameIndex();
+    storeFree(&employeeNameKeys);
+    for (int o = 0; o < NUM_EMPLOYEE_ORDERS; o++) {
+        free(employeeSortIndexes[o].slots);
+        employeeSortIndexes[o].slots = NULL;
+        employeeSortIndexes[o].count = 0;
+        employeeSortIndexes[o].capacity = 0;
+    }
+}
+
+
+
+
+
+
+
+
+// Finds the employees whose name starts with prefix (case-insensitive): they are the run
+// employeeSortIndexes[EMPLOYEE_ORDER_NAME].slots[*first .. *first + count), found by binary
+// search over the folded names. Returns count.
+int findEmployeesByNamePrefix(const char *prefix, int *first) {
+    const EmployeeSortIndex *index = &employeeSortIndexes[EMPLOYEE_ORDER_NAME];
+    char folded[sizeof(((EmployeeNameKey *)0)->folded)];
+    foldName(prefix, folded, sizeof(folded));
+    size_t length = strlen(folded);
+
+    // First entry not sorting before the prefix, then first entry sorting after every match
+    int low = 0, high = index->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (strncmp(employeeNameKey(index->slots[mid]), folded, length) < 0) low = mid + 1;
+        else high = mid;
+    }
+    int start = low;
+    high = index->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (strncmp(employeeNameKey(index->slots[mid]), folded, length) <= 0) low = mid + 1;
+        else high = mid;
+    }
+    *first = start;
+    return low - start;
+}
+
+
+
+
+
+
+
+
+// ATTENDANCE DAY INDEX
+
+// Maps an (employee ID, day number) pair to its home bucket
+unsigned int hashEmployeeDay(int id, int day, int capacity) {
+    unsigned long long key = ((unsigned long long)(unsigned int)id << 32) | (unsigned int)day;
+    key *= 0x9E3779B97F4A7C15ull;
+    return (unsigned int)(key >> 32) & (unsigned int)(capacity - 1);
+}
+
+
+
+
+
+
+
+
+// Re-hashes every entry into a table of the given capacity
+// Returns 1 on success, 0 if memory could not be allocated
+int dayIndexResize(int capacity) {
+    DayIndexEntry *entries = calloc((size_t)capacity, sizeof(DayIndexEntry));
+    if (!entries) return 0;
+
+    for (int i = 0; i < attendanceDayIndex.capacity; i++) {
+        DayIndexEntry entry = attendanceDayIndex.entries[i];
+        if (entry.empID == 0) continue;
+        unsigned int b = hashEmployeeDay(entry.empID, entry.day, capacity);
+        while (entries[b].empID != 0) b = (b + 1) & (unsigned int)(capacity - 1);
+        entries[b] = entry;
+    }
+
+    free(attendanceDayIndex.entries);
+    attendanceDayIndex.entries = entries;
+    attendanceDayIndex.capacity = capacity;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Records that the employee has an attendance record for the day
+// Returns 1 if it was added, 0 if that day was already indexed (the first record wins)
+int dayIndexPut(int id, int day, int record) {
+    if ((attendanceDayIndex.used + 1) * 2 > attendanceDayIndex.capacity) {
+        int capacity = attendanceDayIndex.capacity ? attendanceDayIndex.capacity * 2 : DAY_INDEX_MIN_CAPACITY;
+        if (!dayIndexResize(capacity)) {
+            printf("\t\t\t\t\tOut of memory while growing the attendance index.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    unsigned int mask = (unsigned int)(attendanceDayIndex.capacity - 1);
+    unsigned int b = hashEmployeeDay(id, day, attendanceDayIndex.capacity);
+    while (attendanceDayIndex.entries[b].empID != 0) {
+        if (attendanceDayIndex.entries[b].empID == id && attendanceDayIndex.entries[b].day == day) return 0;
+        b = (b + 1) & mask;
+    }
+    attendanceDayIndex.entries[b].empID = id;
+    attendanceDayIndex.entries[b].day = day;
+    attendanceDayIndex.entries[b].record = record;
+    attendanceDayIndex.used++;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Returns the attendance record index for the employee on that day, or -1 if there is none
+int dayIndexGet(int id, int day) {
+    if (attendanceDayIndex.capacity == 0 || id == 0) return -1;
+    unsigned int mask = (unsigned int)(attendanceDayIndex.capacity - 1);
+    unsigned int b = hashEmployeeDay(id, day, attendanceDayIndex.capacity);
+    while (attendanceDayIndex.entries[b].empID != 0) {
+        if (attendanceDayIndex.entries[b].empID == id && attendanceDayIndex.entries[b].day == day) {
+            return attendanceDayIndex.entries[b].record;
+        }
+        b = (b + 1) & mask;
+    }
+    return -1;
+}
+
+
+
+
+
+
+
+
+// Rebuilds the day index from the attendance log (after loading or compacting it)
+void rebuildAttendanceDayIndex(void) {
+    int capacity = DAY_INDEX_MIN_CAPACITY;
+    while (capacity < attendanceCount * 2) capacity *= 2;
+
+    freeAttendanceDayIndex();
+    if (!dayIndexResize(capacity)) {
+        printStatus("\t\t\t\t\tOut of memory while building the attendance index.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < attendanceCount; i++) {
+        AttendanceRecord *r = attendanceAt(i);
+        dayIndexPut(r->empID, r->day, i);
+    }
+}
+
+
+
+
+
+
+
+
+// Releases the day index
+void freeAttendanceDayIndex(void) {
+    free(attendanceDayIndex.entries);
+    attendanceDayIndex.entries = NULL;
+    attendanceDayIndex.capacity = 0;
+    attendanceDayIndex.used = 0;
+}
+
+
+
+
+
+
+
+
+// Appends a record to the attendance log and indexes it by (empID, day)
+// Returns the new record index, or -1 if memory could not be allocated
+int appendAttendanceRecord(const AttendanceRecord *record) {
+    if (!storeReserve(&attendanceStore, attendanceCount + 1)) return -1;
+    if (!orderIndexReserve(attendanceCount + 1)) return -1;
+    *attendanceAt(attendanceCount) = *record;
+    dayIndexPut(record->empID, record->day, attendanceCount);
+    orderIndexInsert(attendanceCount);
+    return attendanceCount++;
+}
+
+
+
+
+
+
+
+
+// Removes the records whose empID was cleared to 0 from the attendance log and re-indexes it
+// The employees' attendance totals are recounted from the log on the next payroll
+void removeClearedAttendanceRecords(void) {
+    int kept = 0;
+    for (int i = 0; i < attendanceCount; i++) {
+        if (attendanceAt(i)->empID != 0) {
+            *attendanceAt(kept) = *attendanceAt(i);
+            kept++;
+        }
+    }
+    attendanceCount = kept;
+    attendanceFoldedCount = -1;
+    rebuildAttendanceDayIndex();
+    rebuildAttendanceOrderIndex();
+}
+
+
+
+
+
+
+
+
+// ATTENDANCE ORDER INDEX
+
+// Orders two record numbers by their records' (day, empID), then by position in the log
+int compareRecordOrder(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    int order = compareAttendanceRecords(attendanceAt(x), attendanceAt(y));
+    if (order != 0) return order;
+    return x < y ? -1 : x > y;
+}
+
+
+
+
+
+
+
+
+// Makes room for at least capacity entries in the order index
+// Returns 1 on success, 0 if memory could not be allocated
+int orderIndexReserve(int capacity) {
+    if (capacity <= attendanceOrderIndex.capacity) return 1;
+    int grown = attendanceOrderIndex.capacity ? attendanceOrderIndex.capacity : DAY_INDEX_MIN_CAPACITY;
+    while (grown < capacity) grown *= 2;
+    int *records = realloc(attendanceOrderIndex.records, (size_t)grown * sizeof(int));
+    if (!records) return 0;
+    attendanceOrderIndex.records = records;
+    attendanceOrderIndex.capacity = grown;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Adds a record to the order index (room must already be reserved)
+void orderIndexInsert(int record) {
+    int *records = attendanceOrderIndex.records;
+    int count = attendanceOrderIndex.count;
+
+    // Binary search for the first entry that sorts after the new record
+    int low = 0, high = count;
+    if (count > 0 && compareRecordOrder(&records[count - 1], &record) > 0) {
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (compareRecordOrder(&records[mid], &record) <= 0) low = mid + 1;
+            else high = mid;
+        }
+    } else {
+        low = count;
+    }
+    memmove(records + low + 1, records + low, (size_t)(count - low) * sizeof(int));
+    records[low] = record;
+    attendanceOrderIndex.count++;
+}
+
+
+
+
+
+
+
+
+// Returns the position of the first order index entry on or after day
+int orderIndexLowerBound(int day) {
+    int low = 0, high = attendanceOrderIndex.count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (attendanceAt(attendanceOrderIndex.records[mid])->day < day) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+
+
+
+
+
+
+
+// Rebuilds the order index from the attendance log (after loading it or removing records)
+void rebuildAttendanceOrderIndex(void) {
+    attendanceOrderIndex.count = 0;
+    if (!orderIndexReserve(attendanceCount)) {
+        printStatus("\t\t\t\t\tOut of memory while building the attendance index.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < attendanceCount; i++) {
+        attendanceOrderIndex.records[i] = i;
+    }
+    attendanceOrderIndex.count = attendanceCount;
+    qsort(attendanceOrderIndex.records, (size_t)attendanceCount, sizeof(int), compareRecordOrder);
+}
+
+
+
+
+
+
+
+
+// Releases the order index
+void freeAttendanceOrderIndex(void) {
+    free(attendanceOrderIndex.records);
+    attendanceOrderIndex.records = NULL;
+    attendanceOrderIndex.count = 0;
+    attendanceOrderIndex.capacity = 0;
+}
+
+
+
+
+
+
+
+
+// Clears the terminal unless quiet mode is on
+void clearScreen(void) {
+    if (!quietMode) system(CLEAR_COMMAND);
+}
+
+
+
+
+
+
+
+
+// Prints a loading or saving message: indented under the menu as usual, or without the indent
+// on stderr in batch mode
+void printStatus(const char *fmt, ...) {
+    char message[512];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+    if (batchMode) {
+        fputs(message + strspn(message, "\t\n"), stderr);
+    } else {
+        fputs(message, stdout);
+    }
+}
+
+
+
+
+
+
+
+
+// Pauses for an animation step unless quiet mode is on
+void pauseMs(int ms) {
+    if (!quietMode) SLEEP_FUNCTION(ms);
+}
+
+
+
+
+
+
+
+
+// Returns a monotonic wall-clock reading in milliseconds
+double wallClockMs(void) {
+#ifdef _WIN32
+    return (double)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+
+
+
+
+
+
+
+// Reads key=value settings saved next to the data files: quiet=0/1, the kiosk server's
+// group commit policy (commit_batch=<punches>, commit_delay_ms=<ms>) and the pay period
+// (pay_period=monthly|semi-monthly, period_cutoff=<last day of the first half>) and the
+// order employees are listed in (list_order=id|name|position|net pay)
+void loadSettings(void) {
+    FILE *fp = fopen(SETTINGS_FILE, "r");
+    if (!fp) return;
+
+    char line[128], text[32];
+    int value;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "quiet=%d", &value) == 1) quietMode = value != 0;
+        if (sscanf(line, "commit_batch=%d", &value) == 1 && value > 0) groupCommitBatch = value;
+        if (sscanf(line, "commit_delay_ms=%d", &value) == 1 && value >= 0) groupCommitDelayMs = value;
+        if (sscanf(line, "pay_period=%31s", text) == 1) {
+            for (int i = 0; i < NUM_PAY_PERIOD_TYPES; i++) {
+                if (strcasecmp(text, PayPeriodNames[i]) == 0) payPeriodType = (PayPeriodType)i;
+            }
+        }
+        if (sscanf(line, "period_cutoff=%d", &value) == 1 && value >= 1 && value <= MAX_PAY_PERIOD_CUTOFF) {
+            payPeriodCutoff = value;
+        }
+        if (sscanf(line, "list_order=%31[^\r\n]", text) == 1) {
+            for (int i = 0; i < NUM_EMPLOYEE_ORDERS; i++) {
+                if (strcasecmp(text, EmployeeOrderNames[i]) == 0) employeeListOrder = (EmployeeOrder)i;
+            }
+        }
+    }
+    fclose(fp);
+}
+
+
+
+
+
+
+
+
+// Saves the settings file; returns 1 on success
+int saveSettings(void) {
+    char tmpPath[MAX_STR];
+    FILE *fp = beginAtomicWrite(SETTINGS_FILE, tmpPath, sizeof(tmpPath), "w");
+    if (!fp) return 0;
+    fprintf(fp, "quiet=%d\n", quietMode);
+    fprintf(fp, "commit_batch=%d\n", groupCommitBatch);
+    fprintf(fp, "commit_delay_ms=%d\n", groupCommitDelayMs);
+    fprintf(fp, "pay_period=%s\n", PayPeriodNames[payPeriodType]);
+    fprintf(fp, "period_cutoff=%d\n", payPeriodCutoff);
+    fprintf(fp, "list_order=%s\n", EmployeeOrderNames[employeeListOrder]);
+    return commitAtomicWrite(fp, tmpPath, SETTINGS_FILE);
+}
+
+
+
+
+
+
+
+
+// Clears the input buffer to prevent leftover input from affecting subsequent scanf calls
+void clearInputBuffer(void) {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF) {}
+}
+
+
+
+
+
+
+
+// Prompts user to press Enter to continue and waits for input
+void pressEnterToContinue(void) {
+    printf("\n\t\t\t\t                                   Press Enter to continue...");
+    fflush(stdout);
+    clearInputBuffer();
+}
+
+
+
+
+
+
+
+
+// Returns 1 if id is a 7-digit employee ID
+int isValidEmployeeID(int id) {
+    return id >= MIN_EMPLOYEE_ID && id <= MAX_EMPLOYEE_ID;
+}
+
+
+
+
+
+
+
+
+// Adds a new employee record to the store and every index and queues it for saving
+// Returns its slot, or -1 if memory could not be allocated
+int storeNewEmployee(const Employee *e) {
+    if (!storeReserve(&employeeStore, employeeCount + 1) || !employeeIndexesReserve(employeeCount + 1)) return -1;
+    int slot = employeeCount;
+    *employeeAt(slot) = *e;
+    idIndexPut(e->empID, slot);
+    addToEmployeeIndexes(slot);
+    employeeCount++;
+    markEmployeeDirty(slot);
+    return slot;
+}
+
+
+
+
+
+
+
+
+// Hands out the next unused 7-digit employee ID from the ID allocator; 0 when every ID is taken
+int generateEmployeeID(void) {
+    int id;
+    return allocateEmployeeIDs(1, &id) == 1 ? id : 0;
+}
+
+
+
+
+
+
+
+
+// Searches for an employee by their ID and returns the index, or -1 if not found
+int findEmployeeIndexByID(int id) {
+    return idIndexGet(id);
+}
+
+
+
+
+
+
+
+
+// Searches for an employee by their name (case-insensitive) and returns the index, or -1 if not found
+int findEmployeeIndexByName(const char *name) {
+    return nameIndexFind(name, 0);
+}
+
+
+
+
+
+
+
+
+// Case-insensitive string comparison function
+int strcasecmp(const char *s1, const char *s2) {
+    while (*s1 && *s2) {
+        int diff = tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
+        if (diff != 0) return diff;
+        s1++;
+        s2++;
+    }
+    return tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
+}
+
+
+
+
+
+
+
+
+// Checks if an employee name already exists in the system (excluding specified ID)
+int isNameDuplicate(const char *name, int excludeID) {
+    return nameIndexFind(name, excludeID) != -1;
+}
+
+
+
+
+
+
+
+
+// Converts a position name string to its corresponding PositionType enum value
+PositionType getPositionTypeByName(const char *name) {
+    for (int i = 0; i < NUM_POSITIONS; i++) {
+        if (strcmp(name, PositionNames[i]) == 0) {
+            return (PositionType)i;
+        }
+    }
+    return SERVICE_CREW;
+}
+
+
+
+
+
+
+
+
+// Gets integer input from user with validation and range checking
+int getIntInput(const char *prompt, int min, int max) {
+    int value;
+    while (1) {
+        if (prompt) printf("%s", prompt);
+        if (scanf("%d", &value) != 1) {
+            printf("\t\t\t\t\tInvalid input. Please enter a valid number.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+        if (value < min || value > max) {
+            printf("\t\t\t\t\tPlease enter a value between %d and %d.\n", min, max);
+            continue;
+        }
+        return value;
+    }
+}
+
+
+
+
+
+
+
+
+// Strips leading and trailing whitespace from text in place
+void trimInput(char *text) {
+    char *start = text;
+    while (*start && isspace((unsigned char)*start)) start++;
+    size_t n = strlen(start);
+    while (n > 0 && isspace((unsigned char)start[n - 1])) n--;
+    memmove(text, start, n);
+    text[n] = '\0';
+}
+
+
+
+
+
+
+
+
+// Checks trimmed text against the rules for typed input (names when letters_spaces_only is set)
+// Returns NULL if the text is acceptable, otherwise the reason it is not
+const char *validateTextInput(const char *text, int letters_spaces_only) {
+    if (strlen(text) == 0) return "Input cannot be empty or just spaces.";
+
+    if (letters_spaces_only) {
+        int has_letter = 0;
+        for (size_t i = 0; text[i]; ++i) {
+            if (isalpha((unsigned char)text[i])) {
+                has_letter = 1;
+            } else if (text[i] != ' ' && text[i] != '-' && text[i] != '.') {
+                return "Invalid characters detected. Use only letters, spaces, hyphens, or periods.";
+            }
+        }
+        if (!has_letter) return "Name must contain at least one letter.";
+    }
+
+    if (strlen(text) < 2) return "Name must be at least 2 characters long.";
+    if (strlen(text) > 48) return "Name is too long. Maximum 48 characters.";
+    return NULL;
+}
+
+
+
+
+
+
+
+
+// Gets string input from user with validation, trimming, and optional character restrictions
+void getStringInput(const char *prompt, char *out, int maxlen, int letters_spaces_only) {
+    while (1) {
+        if (prompt) printf("%s", prompt);
+        if (!fgets(out, maxlen, stdin)) {
+            clearInputBuffer();
+            printf("\t\t\t\t\tInput error. Please try again.\n");
+            continue;
+        }
+        
+        size_t n = strlen(out);
+        if (n > 0 && out[n-1] == '\n') out[n-1] = '\0';
+        else if (n == (size_t)maxlen - 1) clearInputBuffer();
+        
+        trimInput(out);
+        const char *problem = validateTextInput(out, letters_spaces_only);
+        if (problem) {
+            printf("\t\t\t\t\t%s\n", problem);
+            continue;
+        }
+        return;
+    }
+}
+
+
+
+
+
+
+
+
+// Gets the current system date and time formatted as YYYY-MM-DD and HH:MM
+void getCurrentDateTime(char *date, char *timeBuf) {
+    time_t t = time(NULL);
+    struct tm tm = *localtime(&t);
+    sprintf(date, "%04d-%02d-%02d", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+    sprintf(timeBuf, "%02d:%02d", tm.tm_hour, tm.tm_min);
+}
+
+
+
+
+
+
+
+
+// Converts a YYYY-MM-DD date to a day number (days since 1970-01-01), or -1 if malformed
+int dateToDayNumber(const char *date) {
+    int y, m, d;
+    if (sscanf(date, "%4d-%2d-%2d", &y, &m, &d) != 3) return -1;
+    if (m < 1 || m > 12 || d < 1 || d > 31) return -1;
+    return daysFromCivil(y, m, d);
+}
+
+
+
+
+
+
+
+
+// Converts a calendar date to a day number (days since 1970-01-01)
+int daysFromCivil(int y, int m, int d) {
+    // Days-from-civil: count from 0000-03-01 so the leap day falls at the end of the year
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+
+
+
+
+
+
+
+// Converts a day number back to a YYYY-MM-DD date (date must hold 11 characters)
+void formatDayNumber(int day, char *date) {
+    int y, m, d;
+    civilFromDays(day, &y, &m, &d);
+    sprintf(date, "%04d-%02d-%02d", y, m, d);
+}
+
+
+
+
+
+
+
+
+// Splits a day number into its year, month (1-12) and day of the month
+void civilFromDays(int day, int *year, int *month, int *dayOfMonth) {
+    // Civil-from-days, the inverse of dateToDayNumber
+    int z = day + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    *year = yoe + era * 400 + (m <= 2);
+    *month = m;
+    *dayOfMonth = d;
+}
+
+
+
+
+
+
+
+
+// Converts an HH:MM time to minutes since midnight, or -1 if malformed
+int parseTimeOfDay(const char *timeBuf) {
+    int h, m;
+    if (sscanf(timeBuf, "%2d:%2d", &h, &m) != 2) return -1;
+    if (h < 0 || h > 23 || m < 0 || m > 59) return -1;
+    return h * 60 + m;
+}
+
+
+
+
+
+
+
+
+// Converts minutes since midnight to HH:MM (timeBuf must hold 6 characters)
+void formatTimeOfDay(int minutes, char *timeBuf) {
+    sprintf(timeBuf, "%02d:%02d", (minutes / 60) % 24, minutes % 60);
+}
+
+
+
+
+
+
+
+
+// Converts hours to the hundredths stored in an attendance record, clamped to its range
+unsigned short hoursToHundredths(float hours) {
+    float scaled = hours * 100.0f + 0.5f;
+    if (scaled < 0.0f) return 0;
+    if (scaled > 65535.0f) return 65535;
+    return (unsigned short)scaled;
+}
+
+
+
+
+
+
+
+
+// Converts an attendance status name to its AttendanceStatus enum value
+AttendanceStatus getAttendanceStatusByName(const char *name) {
+    for (int i = 0; i < NUM_ATTENDANCE_STATUSES; i++) {
+        if (strcmp(name, AttendanceStatusNames[i]) == 0) {
+            return (AttendanceStatus)i;
+        }
+    }
+    return ATTENDANCE_PRESENT;
+}
+
+
+
+
+
+
+
+
+// Converts a peso amount (as read from a text file) to centavos, rounding to the nearest centavo
+Money moneyFromPesos(double pesos) {
+    double scaled = pesos * MONEY_SCALE;
+    return (Money)(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+
+
+
+
+
+
+
+// Applies a rate in basis points to an amount, rounding half a centavo away from zero
+Money applyRate(Money amount, int basisPoints) {
+    if (amount < 0) return -applyRate(-amount, basisPoints);
+    return (amount * basisPoints + RATE_SCALE / 2) / RATE_SCALE;
+}
+
+
+
+
+
+
+
+
+// FILE HANDLING
+
+// Returns 1 if path exists and can be read, 0 otherwise
+int fileExists(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return 0;
+    fclose(fp);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Opens a temporary file next to path for an atomic save (tmpPath receives its name)
+FILE *beginAtomicWrite(const char *path, char *tmpPath, size_t tmpSize, const char *mode) {
+    snprintf(tmpPath, tmpSize, "%s.tmp", path);
+    return fopen(tmpPath, mode);
+}
+
+
+
+
+
+
+
+
+// Flushes the temporary file to disk and renames it over path, so readers only ever see
+// the old file or the complete new one
+// Returns 1 on success, 0 on failure (the old file is left untouched)
+int commitAtomicWrite(FILE *fp, const char *tmpPath, const char *path) {
+    int ok = fflush(fp) == 0 && FSYNC_FILE(fp) == 0;
+    if (fclose(fp) != 0) ok = 0;
+    if (!ok) {
+        remove(tmpPath);
+        return 0;
+    }
+#ifdef _WIN32
+    if (!MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        remove(tmpPath);
+        return 0;
+    }
+#else
+    if (rename(tmpPath, path) != 0) {
+        remove(tmpPath);
+        return 0;
+    }
+    // Make the rename itself durable
+    int dirfd = open(".", O_RDONLY);
+    if (dirfd >= 0) {
+        fsync(dirfd);
+        close(dirfd);
+    }
+#endif
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Writes every employee to a text payroll file, ending with a GEN trailer line
+// Returns 1 on success, 0 on failure
+int writeEmployeeText(const char *path, unsigned long long generation) {
+    char tmpPath[MAX_STR];
+    FILE *fp = beginAtomicWrite(path, tmpPath, sizeof(tmpPath), "w");
+    if (!fp) return 0;
+    
+    fprintf(fp, "%d\n", employeeCount);
+    for (int i = 0; i < employeeCount; i++) {
+        fprintf(fp, "%d\n%s\n%s\n%.2f\n%d\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n%.2f\n",
+            employeeAt(i)->empID,
+            employeeAt(i)->name,
+            PositionNames[employeeAt(i)->position],
+            PESOS(employeeAt(i)->monthlySalary),
+            employeeAt(i)->daysWorked,
+            employeeAt(i)->totalOvertimeHours,
+            employeeAt(i)->totalHoursWorked,
+            PESOS(employeeAt(i)->lastOvertimePay),
+            PESOS(employeeAt(i)->lastDailyRate),
+            PESOS(employeeAt(i)->lastAbsentDeduct),
+            PESOS(employeeAt(i)->lastGrossPay),
+            PESOS(employeeAt(i)->lastNetPay),
+            PESOS(employeeAt(i)->lastSSS),
+            PESOS(employeeAt(i)->lastPhilHealth),
+            PESOS(employeeAt(i)->lastPagIBIG),
+            PESOS(employeeAt(i)->lastIncomeTax)
+        );
+    }
+    fprintf(fp, "GEN %llu NEXTID %d\n", generation, employeeIDAllocator.next);
+    return commitAtomicWrite(fp, tmpPath, path);
+}
+
+
+
+
+
+
+
+
+// Saves all employee records to the payroll file
+void saveToFile(void) {
+    unsigned long long generation = payrollGeneration + 1;
+    const char *path = useBinarySnapshots ? BINARY_FILENAME : FILENAME;
+    int ok = useBinarySnapshots
+        ? writeSnapshot(BINARY_FILENAME, SNAPSHOT_KIND_EMPLOYEES, &employeeStore, employeeCount, generation)
+        : writeEmployeeText(FILENAME, generation);
+
+    if (!ok) {
+        printStatus("\n\t\t\t\t\tError: Unable to save data to %s. The previous file was kept.\n", path);
+        return;
+    }
+    payrollGeneration = generation;
+    employeeIDAllocator.savedNext = employeeIDAllocator.next;
+    clearPendingSaves();
+    resetPayrollJournal();
+}
+
+
+
+
+
+
+
+
+// Loads all employee records from the payroll file, then replays the payroll journal on top
+void loadFromFile(void) {
+    loadPayrollSnapshot();
+
+    int replayed = replayPayrollJournal();
+    for (int i = 0; i < employeeCount; i++) {
+        employeeAt(i)->dirty = 0;
+        employeeAt(i)->changeGeneration = 1;
+        employeeAt(i)->computedGeneration = 0;
+    }
+    rebuildEmployeeIDIndex();
+    rebuildEmployeeIDAllocator();
+    rebuildEmployeeIndexes();
+    if (replayed > 0) {
+        printStatus("\t\t\t\t\tReplayed %d saved changes from the payroll journal.\n", replayed);
+    }
+}
+
+
+
+
+
+
+
+
+// Loads the payroll snapshot (a valid binary snapshot takes precedence over the text file)
+void loadPayrollSnapshot(void) {
+    int loaded = loadSnapshot(BINARY_FILENAME, SNAPSHOT_KIND_EMPLOYEES, &employeeStore, &employeeCount,
+                              &payrollGeneration);
+    if (loaded == 1) {
+        useBinarySnapshots = 1;
+        printStatus("\t\t\t\t\tLoaded %d employees and their payroll data from %s.\n", employeeCount, BINARY_FILENAME);
+        return;
+    }
+    if (loaded == -1) {
+        printStatus("\t\t\t\t\t%s is damaged or from another version. Reading %s instead.\n", BINARY_FILENAME, FILENAME);
+    }
+
+    FILE *fp = fopen(FILENAME, "r");
+    if (!fp) {
+        printStatus("\t\t\t\t\tNo existing payroll file found. Starting fresh.\n");
+        employeeCount = 0;
+        return;
+    }
+    
+    int expected = 0;
+    if (fscanf(fp, "%d\n", &expected) != 1) {
+        printStatus("\t\t\t\t\tError reading employee count from file. Starting fresh.\n");
+        employeeCount = 0;
+        fclose(fp);
+        return;
+    }
+
+    char posName[50];
+    employeeCount = 0;
+    for (int i = 0; i < expected; i++) {
+        Employee e = {0};
+        if (fscanf(fp, "%d\n", &e.empID) != 1) break;
+
+        if (!fgets(e.name, sizeof(e.name), fp)) break;
+        e.name[strcspn(e.name, "\n")] = 0;
+
+        if (!fgets(posName, sizeof(posName), fp)) break;
+        posName[strcspn(posName, "\n")] = 0;
+        e.position = getPositionTypeByName(posName);
+
+        // Files written before lastIncomeTax was saved end after 12 fields
+        double monthlySalary, overtimePay, dailyRate, absentDeduct, grossPay, netPay;
+        double sss, philHealth, pagIBIG, incomeTax = 0.0;
+        int fields = fscanf(fp, "%lf\n%d\n%f\n%f\n%lf\n%lf\n%lf\n%lf\n%lf\n%lf\n%lf\n%lf\n%lf\n",
+            &monthlySalary,
+            &e.daysWorked,
+            &e.totalOvertimeHours,
+            &e.totalHoursWorked,
+            &overtimePay,
+            &dailyRate,
+            &absentDeduct,
+            &grossPay,
+            &netPay,
+            &sss,
+            &philHealth,
+            &pagIBIG,
+            &incomeTax);
+        if (fields < 12) break;
+        e.monthlySalary = moneyFromPesos(monthlySalary);
+        e.lastOvertimePay = moneyFromPesos(overtimePay);
+        e.lastDailyRate = moneyFromPesos(dailyRate);
+        e.lastAbsentDeduct = moneyFromPesos(absentDeduct);
+        e.lastGrossPay = moneyFromPesos(grossPay);
+        e.lastNetPay = moneyFromPesos(netPay);
+        e.lastSSS = moneyFromPesos(sss);
+        e.lastPhilHealth = moneyFromPesos(philHealth);
+        e.lastPagIBIG = moneyFromPesos(pagIBIG);
+        e.lastIncomeTax = moneyFromPesos(incomeTax);
+
+        if (!storeReserve(&employeeStore, employeeCount + 1)) {
+            printStatus("\t\t\t\t\tOut of memory while loading employees.\n");
+            break;
+        }
+        *employeeAt(employeeCount++) = e;
+    }
+
+    payrollGeneration = 0;
+    int nextID = 0;
+    if (employeeCount < expected) {
+        printStatus("\t\t\t\t\tWarning: %s ended after %d of %d employees.\n", FILENAME, employeeCount, expected);
+    } else if (fscanf(fp, "GEN %llu NEXTID %d", &payrollGeneration, &nextID) < 1) {
+        payrollGeneration = 0;
+    }
+    setNextEmployeeID(nextID);
+
+    if (employeeCount > 0) {
+        printStatus("\t\t\t\t\tLoaded %d employees and their payroll data from file.\n", employeeCount);
+    }
+    fclose(fp);
+}
+
+
+
+
+
+
+
+
+// Writes count attendance records of a store to a text attendance file, ending with a GEN trailer line
+// Returns 1 on success, 0 on failure
+int writeAttendanceText(const char *path, const ChunkedStore *store, int count, unsigned long long generation) {
+    char tmpPath[MAX_STR];
+    FILE *fp = beginAtomicWrite(path, tmpPath, sizeof(tmpPath), "w");
+    if (!fp) return 0;
+    
+    char date[11], timeBuf[6];
+    fprintf(fp, "%d\n", count);
+    for (int i = 0; i < count; i++) {
+        const AttendanceRecord *r = storeAt(store, i);
+        formatDayNumber(r->day, date);
+        formatTimeOfDay(r->timeIn, timeBuf);
+        fprintf(fp, "%d\n%s\n%s\n%.2f\n%s\n%d\n%.2f\n",
+            r->empID,
+            date,
+            timeBuf,
+            r->hoursWorked / 100.0,
+            AttendanceStatusNames[r->status],
+            r->isLate,
+            r->overtimeHours / 100.0
+        );
+    }
+    fprintf(fp, "GEN %llu\n", generation);
+    return commitAtomicWrite(fp, tmpPath, path);
+}
+
+
+
+
+
+
+
+
+// Saves the active month's attendance to its partition file (the snapshot) and empties the
+// journal, since every journaled punch is now part of the snapshot
+// Returns 1 on success, 0 if the previous file (and the journal) was kept
+int saveAttendanceToFile(void) {
+    unsigned long long generation = attendanceGeneration + 1;
+    if (!writeAttendancePartition(activePartitionMonth, &attendanceStore, attendanceCount, generation)) {
+        char path[MAX_STR];
+        partitionPath(activePartitionMonth, useBinarySnapshots, path, sizeof(path));
+        printStatus("\n\t\t\t\t\tError: Unable to save attendance data to %s. The previous file was kept.\n", path);
+        return 0;
+    }
+    attendanceGeneration = generation;
+    resetAttendanceJournal();
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Starts an empty journal that extends the active month's snapshot generation
+void resetAttendanceJournal(void) {
+    char tmpPath[MAX_STR], monthText[8];
+    formatPartitionMonth(activePartitionMonth, monthText);
+    FILE *fp = beginAtomicWrite(ATTENDANCE_JOURNAL_FILE, tmpPath, sizeof(tmpPath), "w");
+    if (fp) {
+        fprintf(fp, "GEN %llu %s\n", attendanceGeneration, monthText);
+        commitAtomicWrite(fp, tmpPath, ATTENDANCE_JOURNAL_FILE);
+    }
+    attendanceJournalCount = 0;
+}
+
+
+
+
+
+
+
+
+// Fills a compact attendance record from its text fields
+// Returns 1 on success, 0 if the date is malformed
+int parseAttendanceRecord(AttendanceRecord *r, int empID, const char *date, const char *timeBuf,
+                          float hoursWorked, const char *status, int isLate, float overtimeHours) {
+    memset(r, 0, sizeof(*r));
+    r->empID = empID;
+    r->day = dateToDayNumber(date);
+    if (r->day < 0) return 0;
+
+    int minutes = parseTimeOfDay(timeBuf);
+    r->timeIn = (unsigned short)(minutes < 0 ? 0 : minutes);
+    r->hoursWorked = hoursToHundredths(hoursWorked);
+    r->status = getAttendanceStatusByName(status);
+    r->isLate = isLate != 0;
+    r->overtimeHours = hoursToHundredths(overtimeHours);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Reads a text attendance file into store, replacing its contents
+// Returns 1 if the file was read, 0 if it does not exist
+int readAttendanceText(const char *path, ChunkedStore *store, int *count, unsigned long long *generation) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) return 0;
+
+    *count = 0;
+    *generation = 0;
+    int expected = 0;
+    if (fscanf(fp, "%d\n", &expected) != 1) {
+        printStatus("\t\t\t\t\tError reading attendance count from %s. Starting fresh.\n", path);
+        expected = 0;
+    }
+
+    // Text fields are read a whole line at a time and converted to the compact record
+    char date[64], timeBuf[64], status[64];
+    for (int i = 0; i < expected; i++) {
+        AttendanceRecord r;
+        int empID, isLate;
+        float hoursWorked, overtimeHours;
+        if (fscanf(fp, "%d\n", &empID) != 1) break;
+        if (!fgets(date, sizeof(date), fp)) break;
+        if (!fgets(timeBuf, sizeof(timeBuf), fp)) break;
+        if (fscanf(fp, "%f\n", &hoursWorked) != 1) break;
+        if (!fgets(status, sizeof(status), fp)) break;
+        status[strcspn(status, "\r\n")] = 0;
+        if (fscanf(fp, "%d\n%f\n", 
+            &isLate,
+            &overtimeHours) != 2) break;
+
+        if (!parseAttendanceRecord(&r, empID, date, timeBuf, hoursWorked, status, isLate, overtimeHours)) break;
+        if (!storeReserve(store, *count + 1)) {
+            printStatus("\t\t\t\t\tOut of memory while loading attendance records.\n");
+            break;
+        }
+        *(AttendanceRecord *)storeAt(store, (*count)++) = r;
+    }
+
+    if (*count < expected) {
+        printStatus("\t\t\t\t\tWarning: %s ended after %d of %d records.\n", path, *count, expected);
+    } else if (fscanf(fp, "GEN %llu", generation) != 1) {
+        *generation = 0;
+    }
+    fclose(fp);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Loads the current month's attendance partition, then replays the journal on top
+// A journal left behind in an earlier month is first folded into that month's file, and the
+// single attendance file of earlier versions is split into monthly files on first run
+// In read-only mode nothing is written: such a journal's month simply stays the active one
+void loadAttendanceFromFile(void) {
+    attendanceCount = 0;
+    freeAttendanceDayIndex();
+    if (!readOnlyMode) {
+        migrateLegacyAttendance();
+    } else if (fileExists(ATTENDANCE_FILE) || fileExists(ATTENDANCE_BINARY_FILE)) {
+        printStatus("\t\t\t\t\tNote: %s has not been split into monthly files yet and is not included.\n",
+                    ATTENDANCE_FILE);
+    }
+
+    int current = currentPartitionMonth();
+    int journalMonth = attendanceJournalMonth();
+    if (readOnlyMode && journalMonth >= 0) current = journalMonth;
+    if (journalMonth >= 0 && journalMonth != current) {
+        openAttendancePartition(journalMonth);
+        // If that month cannot be saved it stays active so its journal is not lost;
+        // the next punch tries again to move on to the current month
+        if (attendanceJournalCount > 0 && !saveAttendanceToFile()) return;
+    }
+
+    int snapshotCount = openAttendancePartition(current);
+    if (journalMonth != current && !readOnlyMode) resetAttendanceJournal();
+
+    char monthText[8];
+    formatPartitionMonth(current, monthText);
+    if (snapshotCount > 0) {
+        printStatus("\t\t\t\t\tLoaded %d attendance records for %s from file.\n", snapshotCount, monthText);
+    }
+    if (attendanceCount > snapshotCount) {
+        printStatus("\t\t\t\t\tReplayed %d punches from the attendance journal.\n", attendanceCount - snapshotCount);
+    }
+}
+
+
+
+
+
+
+
+
+// Formats a record as one journal line ("empID date time hours status isLate overtime\n")
+// Returns the line length
+size_t formatJournalLine(const AttendanceRecord *r, char *line, size_t size) {
+    char date[11], timeBuf[6];
+    formatDayNumber(r->day, date);
+    formatTimeOfDay(r->timeIn, timeBuf);
+    int n = snprintf(line, size, "%d %s %s %.2f %s %d %.2f\n",
+        r->empID,
+        date,
+        timeBuf,
+        r->hoursWorked / 100.0,
+        AttendanceStatusNames[r->status],
+        r->isLate,
+        r->overtimeHours / 100.0);
+    return n > 0 ? (size_t)n : 0;
+}
+
+
+
+
+
+
+
+
+// Appends count journal lines with one write and one fsync, so they become durable together
+// A failed append is cut back off the journal, so a restart does not replay any of its lines
+// Returns 1 once the lines are durable, 0 if they could not be written
+int commitAttendanceJournal(const char *lines, size_t len, int count) {
+    FILE *fp = fopen(ATTENDANCE_JOURNAL_FILE, "a");
+    int ok = fp != NULL;
+    if (ok) {
+        fseek(fp, 0, SEEK_END);
+        long start = ftell(fp);
+        if (start == 0) {
+            char monthText[8];
+            formatPartitionMonth(activePartitionMonth, monthText);
+            fprintf(fp, "GEN %llu %s\n", attendanceGeneration, monthText);
+        }
+        ok = fwrite(lines, 1, len, fp) == len && fflush(fp) == 0 && FSYNC_FILE(fp) == 0;
+        if (!ok && start >= 0) {
+            fflush(fp);
+            if (TRUNCATE_FILE(fp, start) != 0) {
+                fprintf(stderr, "Error: %s may end with part of a batch that was not saved.\n", ATTENDANCE_JOURNAL_FILE);
+            }
+        }
+        ok = fclose(fp) == 0 && ok;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Unable to append to %s.\n", ATTENDANCE_JOURNAL_FILE);
+        return 0;
+    }
+
+    atomic_fetch_add(&journalCommits, 1);
+    atomic_fetch_add(&journalCommittedPunches, count);
+    if (count > atomic_load(&journalLargestCommit)) atomic_store(&journalLargestCommit, count);
+    int bucket = count <= 1 ? 0 : count <= 4 ? 1 : count <= 16 ? 2 : count <= 64 ? 3 : 4;
+    atomic_fetch_add(&journalCommitsBySize[bucket], 1);
+
+    attendanceJournalCount += count;
+    if (attendanceJournalCount >= JOURNAL_COMPACT_THRESHOLD) {
+        compactAttendanceJournal();
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Appends one record to the attendance journal as a batch of one
+// Falls back to saving the full attendance file if the journal cannot be written
+void journalAttendanceRecord(const AttendanceRecord *r) {
+    char line[JOURNAL_LINE_SIZE];
+    size_t len = formatJournalLine(r, line, sizeof(line));
+    if (!commitAttendanceJournal(line, len, 1)) {
+        fprintf(stderr, "Saving full attendance file instead.\n");
+        saveAttendanceToFile();
+    }
+}
+
+
+
+
+
+
+
+
+// Parses one journal-format line ("empID date time hours status isLate overtime")
+int parseAttendanceLine(const char *line, AttendanceRecord *r) {
+    int empID, isLate;
+    float hoursWorked, overtimeHours;
+    char date[11], timeBuf[6], status[20];
+
+    if (sscanf(line, "%d %10s %5s %f %19s %d %f",
+               &empID, date, timeBuf, &hoursWorked, status, &isLate, &overtimeHours) != 7) return 0;
+    return parseAttendanceRecord(r, empID, date, timeBuf, hoursWorked, status, isLate, overtimeHours);
+}
+
+
+
+
+
+
+
+
+// Re-applies the punches in the attendance journal that are not already in the snapshot
+// Only a journal extending the active month is replayed. A journal whose GEN line is older
+// than the snapshot was already folded into it (the program stopped between writing the
+// snapshot and resetting the journal) and is skipped, as are lines for other months (punches
+// held for a group commit while the month changed, which are already in their month's file)
+// Returns the number of records added
+int replayAttendanceJournal(void) {
+    attendanceJournalCount = 0;
+    FILE *fp = fopen(ATTENDANCE_JOURNAL_FILE, "r");
+    if (!fp) return 0;
+
+    int added = 0;
+    int stale = 0;
+    char line[128], monthText[16];
+    unsigned long long journalGeneration;
+    while (fgets(line, sizeof(line), fp)) {
+        int fields = sscanf(line, "GEN %llu %15s", &journalGeneration, monthText);
+        if (fields >= 1) {
+            // A GEN line without a month comes from the single-file format (see migrateLegacyAttendance)
+            int journalMonth = fields == 2 ? parsePartitionMonth(monthText) : -1;
+            if (journalMonth != activePartitionMonth) break;
+            stale = journalGeneration < attendanceGeneration;
+            if (stale) break;
+            continue;
+        }
+
+        AttendanceRecord r;
+
+        // A torn last line (crash mid-append) simply fails to parse and is skipped
+        if (strchr(line, '\n') == NULL) break;
+        if (!parseAttendanceLine(line, &r)) continue;
+
+        attendanceJournalCount++;
+        if (activePartitionMonth >= 0 && monthOfDay(r.day) != activePartitionMonth) continue;
+        if (dayIndexGet(r.empID, r.day) != -1) continue;
+        if (appendAttendanceRecord(&r) < 0) {
+            printStatus("\t\t\t\t\tOut of memory while replaying the attendance journal.\n");
+            break;
+        }
+        added++;
+    }
+    fclose(fp);
+
+    // Start a fresh journal so new punches are not appended behind the stale GEN line
+    if (stale && !readOnlyMode) resetAttendanceJournal();
+    return added;
+}
+
+
+
+
+
+
+
+
+// Folds the attendance journal into the attendance file if it holds any punches
+void compactAttendanceJournal(void) {
+    if (attendanceJournalCount == 0) return;
+    saveAttendanceToFile();
+}
+
+
+
+
+
+
+
+
+// ATTENDANCE PARTITIONS
+
+// Returns the partition month a day belongs to (months since 0000-01)
+int monthOfDay(int day) {
+    int y, m, d;
+    civilFromDays(day, &y, &m, &d);
+    return y * 12 + m - 1;
+}
+
+
+
+
+
+
+
+
+// Returns the partition month of today's date
+int currentPartitionMonth(void) {
+    time_t t = time(NULL);
+    struct tm tm = *localtime(&t);
+    return (tm.tm_year + 1900) * 12 + tm.tm_mon;
+}
+
+
+
+
+
+
+
+
+// Formats a partition month as YYYY-MM (text must hold 8 characters)
+void formatPartitionMonth(int month, char *text) {
+    sprintf(text, "%04u-%02u", (unsigned)(month / 12) % 10000u, (unsigned)month % 12u + 1);
+}
+
+
+
+
+
+
+
+
+// Converts a YYYY-MM month to a partition month, or -1 if malformed
+int parsePartitionMonth(const char *text) {
+    int y, m;
+    char extra;
+    if (sscanf(text, "%4d-%2d%c", &y, &m, &extra) != 2) return -1;
+    if (y < 1 || m < 1 || m > 12) return -1;
+    return y * 12 + m - 1;
+}
+
+
+
+
+
+
+
+
+// Builds the file name of a month's attendance partition
+void partitionPath(int month, int binary, char *path, size_t size) {
+    char monthText[8];
+    formatPartitionMonth(month, monthText);
+    snprintf(path, size, "%s%s.%s", ATTENDANCE_PARTITION_PREFIX, monthText, binary ? "bin" : "txt");
+}
+
+
+
+
+
+
+
+
+// Returns the month of an attendance partition file name (attendance_YYYY-MM.txt or .bin),
+// or -1 for any other file
+int partitionMonthOfFile(const char *name) {
+    size_t prefixLen = strlen(ATTENDANCE_PARTITION_PREFIX);
+    if (strncmp(name, ATTENDANCE_PARTITION_PREFIX, prefixLen) != 0 || strlen(name) != prefixLen + 11) return -1;
+    const char *suffix = name + prefixLen + 7;
+    if (strcmp(suffix, ".txt") != 0 && strcmp(suffix, ".bin") != 0) return -1;
+
+    char monthText[8];
+    memcpy(monthText, name + prefixLen, 7);
+    monthText[7] = '\0';
+    return parsePartitionMonth(monthText);
+}
+
+
+
+
+
+
+
+
+// Compares two partition months (qsort comparator)
+int comparePartitionMonths(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+
+
+
+
+
+
+
+// Finds every month with a partition file in the working directory
+// Returns the number of months, stored ascending in a malloc'd *months, or -1 if out of memory
+int listAttendancePartitions(int **months) {
+    int count = 0, capacity = 16;
+    int *list = malloc((size_t)capacity * sizeof(int));
+    if (!list) return -1;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA found;
+    HANDLE dir = FindFirstFileA(ATTENDANCE_PARTITION_PREFIX "*", &found);
+    int more = dir != INVALID_HANDLE_VALUE;
+    while (more) {
+        const char *name = found.cFileName;
+#else
+    DIR *dir = opendir(".");
+    struct dirent *entry;
+    while (dir && (entry = readdir(dir)) != NULL) {
+        const char *name = entry->d_name;
+#endif
+        int month = partitionMonthOfFile(name);
+        if (month >= 0) {
+            if (count == capacity) {
+                int *grown = realloc(list, (size_t)capacity * 2 * sizeof(int));
+                if (!grown) {
+                    count = -1;
+                    break;
+                }
+                list = grown;
+                capacity *= 2;
+            }
+            list[count++] = month;
+        }
+#ifdef _WIN32
+        more = FindNextFileA(dir, &found);
+    }
+    if (dir != INVALID_HANDLE_VALUE) FindClose(dir);
+#else
+    }
+    if (dir) closedir(dir);
+#endif
+
+    if (count < 0) {
+        free(list);
+        return -1;
+    }
+    // A month with both a text and a binary file is listed once
+    qsort(list, (size_t)count, sizeof(int), comparePartitionMonths);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || list[unique - 1] != list[i]) list[unique++] = list[i];
+    }
+    *months = list;
+    return unique;
+}
+
+
+
+
+
+
+
+
+// Reads one month's attendance into store, preferring its binary snapshot over the text file
+// Returns 0 if the month has no file, 1 if it was read from text, 2 from a binary snapshot
+int loadAttendancePartition(int month, ChunkedStore *store, int *count, unsigned long long *generation) {
+    char binaryPath[MAX_STR], textPath[MAX_STR];
+    partitionPath(month, 1, binaryPath, sizeof(binaryPath));
+    partitionPath(month, 0, textPath, sizeof(textPath));
+
+    *count = 0;
+    *generation = 0;
+    int loaded = loadSnapshot(binaryPath, SNAPSHOT_KIND_ATTENDANCE, store, count, generation);
+    if (loaded == 1) return 2;
+    if (loaded == -1) {
+        printStatus("\t\t\t\t\t%s is damaged or from another version. Reading %s instead.\n", binaryPath, textPath);
+    }
+    return readAttendanceText(textPath, store, count, generation);
+}
+
+
+
+
+
+
+
+
+// Writes one month's attendance in the current file format; writing text removes the month's
+// binary snapshot, which would otherwise be loaded in its place
+// Returns 1 on success, 0 on failure
+int writeAttendancePartition(int month, const ChunkedStore *store, int count, unsigned long long generation) {
+    char path[MAX_STR];
+    partitionPath(month, useBinarySnapshots, path, sizeof(path));
+    if (useBinarySnapshots) return writeSnapshot(path, SNAPSHOT_KIND_ATTENDANCE, store, count, generation);
+
+    if (!writeAttendanceText(path, store, count, generation)) return 0;
+    partitionPath(month, 1, path, sizeof(path));
+    remove(path);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Makes month the active partition: loads its records into the attendance store and replays
+// the journal if the journal extends this month
+// Returns the number of records read from the partition file
+int openAttendancePartition(int month) {
+    attendanceCount = 0;
+    attendanceFoldedCount = -1;
+    activePartitionMonth = month;
+    if (loadAttendancePartition(month, &attendanceStore, &attendanceCount, &attendanceGeneration) == 2) {
+        useBinarySnapshots = 1;
+    }
+    rebuildAttendanceDayIndex();
+    rebuildAttendanceOrderIndex();
+
+    int snapshotCount = attendanceCount;
+    replayAttendanceJournal();
+    return snapshotCount;
+}
+
+
+
+
+
+
+
+
+// Saves the active month and makes month active in its place (the calendar moved on while
+// the program was running); payroll totals are rebuilt from the new month when next computed
+// Returns 1 on success, 0 if the active month could not be saved and was kept
+int switchAttendancePartition(int month) {
+    if (!saveAttendanceToFile()) return 0;
+    openAttendancePartition(month);
+    resetAttendanceJournal();
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Returns the month named on the attendance journal's GEN line, or -1 if there is no journal
+// or it was written by the single-file format
+int attendanceJournalMonth(void) {
+    FILE *fp = fopen(ATTENDANCE_JOURNAL_FILE, "r");
+    if (!fp) return -1;
+
+    char line[64], monthText[16];
+    unsigned long long generation;
+    int month = -1;
+    if (fgets(line, sizeof(line), fp) && sscanf(line, "GEN %llu %15s", &generation, monthText) == 2) {
+        month = parsePartitionMonth(monthText);
+    }
+    fclose(fp);
+    return month;
+}
+
+
+
+
+
+
+
+
+// Orders attendance records by day, then employee ID (qsort/bsearch comparator)
+int compareAttendanceRecords(const void *a, const void *b) {
+    const AttendanceRecord *x = a;
+    const AttendanceRecord *y = b;
+    if (x->day != y->day) return x->day < y->day ? -1 : 1;
+    if (x->empID != y->empID) return x->empID < y->empID ? -1 : 1;
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Adds records to a month's partition file, skipping any (employee, day) already recorded
+// month must not be the active partition; records must all fall in it and are sorted in place
+// Returns the number of records added, or -1 if the partition could not be written
+int mergeAttendancePartition(int month, AttendanceRecord *records, int count, int *duplicates) {
+    ChunkedStore partition = { NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+    int partitionCount = 0;
+    unsigned long long generation = 0;
+    loadAttendancePartition(month, &partition, &partitionCount, &generation);
+
+    // A sorted copy of the existing records answers the duplicate checks by binary search
+    AttendanceRecord *existing = malloc((size_t)(partitionCount ? partitionCount : 1) * sizeof(AttendanceRecord));
+    int added = -1;
+    *duplicates = 0;
+    if (existing && storeReserve(&partition, partitionCount + count)) {
+        for (int i = 0; i < partitionCount; i++) {
+            existing[i] = *(AttendanceRecord *)storeAt(&partition, i);
+        }
+        qsort(existing, (size_t)partitionCount, sizeof(AttendanceRecord), compareAttendanceRecords);
+        qsort(records, (size_t)count, sizeof(AttendanceRecord), compareAttendanceRecords);
+
+        added = 0;
+        for (int i = 0; i < count; i++) {
+            if ((i > 0 && compareAttendanceRecords(&records[i - 1], &records[i]) == 0)
+                || bsearch(&records[i], existing, (size_t)partitionCount, sizeof(AttendanceRecord), compareAttendanceRecords)) {
+                (*duplicates)++;
+                continue;
+            }
+            *(AttendanceRecord *)storeAt(&partition, partitionCount + added) = records[i];
+            added++;
+        }
+        if (added > 0 && !writeAttendancePartition(month, &partition, partitionCount + added, generation + 1)) {
+            added = -1;
+        }
+    }
+
+    dropCachedPartition(month);
+    free(existing);
+    storeFree(&partition);
+    return added;
+}
+
+
+
+
+
+
+
+
+// Deletes a removed employee's records from every month's partition file except the active
+// one (its records are removed from the attendance store), so a reused ID starts with none
+// Returns 1 on success, 0 if a partition could not be listed or rewritten
+int purgeEmployeeAttendance(int empID) {
+    int *months;
+    int monthCount = listAttendancePartitions(&months);
+    if (monthCount < 0) return 0;
+
+    int ok = 1;
+    for (int m = 0; m < monthCount; m++) {
+        if (months[m] == activePartitionMonth) continue;
+
+        ChunkedStore partition = { NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+        int partitionCount = 0;
+        unsigned long long generation = 0;
+        loadAttendancePartition(months[m], &partition, &partitionCount, &generation);
+
+        int kept = 0;
+        for (int i = 0; i < partitionCount; i++) {
+            AttendanceRecord *r = storeAt(&partition, i);
+            if (r->empID != empID) *(AttendanceRecord *)storeAt(&partition, kept++) = *r;
+        }
+        if (kept < partitionCount) {
+            if (!writeAttendancePartition(months[m], &partition, kept, generation + 1)) ok = 0;
+            dropCachedPartition(months[m]);
+        }
+        storeFree(&partition);
+    }
+    free(months);
+    return ok;
+}
+
+
+
+
+
+
+
+
+// Splits the attendance file of earlier versions (every month in one file, plus its journal)
+// into monthly partition files; the old files are kept with a .migrated suffix
+void migrateLegacyAttendance(void) {
+    attendanceCount = 0;
+    int loaded = loadSnapshot(ATTENDANCE_BINARY_FILE, SNAPSHOT_KIND_ATTENDANCE, &attendanceStore, &attendanceCount,
+                              &attendanceGeneration);
+    if (loaded == 1) {
+        useBinarySnapshots = 1;
+    } else if (!readAttendanceText(ATTENDANCE_FILE, &attendanceStore, &attendanceCount, &attendanceGeneration)) {
+        return;
+    }
+
+    // The old journal's GEN line has no month, which matches no active partition
+    activePartitionMonth = -1;
+    rebuildAttendanceDayIndex();
+    rebuildAttendanceOrderIndex();
+    replayAttendanceJournal();
+
+    // Sorting by day groups the records into runs of one month each
+    AttendanceRecord *records = malloc((size_t)(attendanceCount ? attendanceCount : 1) * sizeof(AttendanceRecord));
+    int ok = records != NULL;
+    for (int i = 0; ok && i < attendanceCount; i++) records[i] = *attendanceAt(i);
+    if (ok) qsort(records, (size_t)attendanceCount, sizeof(AttendanceRecord), compareAttendanceRecords);
+
+    int months = 0;
+    for (int first = 0; ok && first < attendanceCount; months++) {
+        int month = monthOfDay(records[first].day);
+        int last = first + 1;
+        while (last < attendanceCount && monthOfDay(records[last].day) == month) last++;
+        int duplicates;
+        ok = mergeAttendancePartition(month, records + first, last - first, &duplicates) >= 0;
+        first = last;
+    }
+    free(records);
+
+    if (ok) {
+        remove(ATTENDANCE_FILE ".migrated");
+        remove(ATTENDANCE_BINARY_FILE ".migrated");
+        rename(ATTENDANCE_FILE, ATTENDANCE_FILE ".migrated");
+        rename(ATTENDANCE_BINARY_FILE, ATTENDANCE_BINARY_FILE ".migrated");
+        printStatus("\t\t\t\t\tMoved %d attendance records from %s into %d monthly files.\n", attendanceCount, ATTENDANCE_FILE, months);
+    } else {
+        printStatus("\t\t\t\t\tError: Unable to split %s into monthly files. It was kept as is.\n", ATTENDANCE_FILE);
+    }
+    attendanceCount = 0;
+    freeAttendanceDayIndex();
+    freeAttendanceOrderIndex();
+}
+
+
+
+
+
+
+
+
+// Finds a month's attendance for a report, reading an earlier month's partition on first use
+// The active month is served from the attendance store itself
+// Returns 1 if the month has any records, 0 if it has none
+int attendanceForMonth(int month, const ChunkedStore **store, int *count) {
+    if (month == activePartitionMonth) {
+        *store = &attendanceStore;
+        *count = attendanceCount;
+        return attendanceCount > 0;
+    }
+
+    AttendancePartition *p = NULL;
+    for (int i = 0; i < partitionCacheCount && !p; i++) {
+        if (partitionCache[i].month == month) p = &partitionCache[i];
+    }
+    if (!p) {
+        if (partitionCacheCount < PARTITION_CACHE_SIZE) {
+            p = &partitionCache[partitionCacheCount++];
+            p->store = (ChunkedStore){ NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+        } else {
+            // Reuse the slot of the partition read longest ago (its chunks are kept for the new one)
+            p = &partitionCache[partitionCacheNext];
+            partitionCacheNext = (partitionCacheNext + 1) % PARTITION_CACHE_SIZE;
+        }
+        unsigned long long generation;
+        p->month = month;
+        loadAttendancePartition(month, &p->store, &p->count, &generation);
+    }
+
+    *store = &p->store;
+    *count = p->count;
+    return p->count > 0;
+}
+
+
+
+
+
+
+
+
+// Forgets a cached month after its partition file changed
+void dropCachedPartition(int month) {
+    for (int i = 0; i < partitionCacheCount; i++) {
+        if (partitionCache[i].month == month) {
+            storeFree(&partitionCache[i].store);
+            partitionCache[i] = partitionCache[--partitionCacheCount];
+            return;
+        }
+    }
+}
+
+
+
+
+
+
+
+
+// Releases every cached month
+void freePartitionCache(void) {
+    for (int i = 0; i < partitionCacheCount; i++) {
+        storeFree(&partitionCache[i].store);
+    }
+    partitionCacheCount = 0;
+    partitionCacheNext = 0;
+}
+
+
+
+
+
+
+
+
+// PAY PERIODS
+
+// Finds the pay period containing day: its whole month, or for semi-monthly pay either the
+// 1st to the cutoff day or the day after the cutoff to the end of the month
+void payPeriodContaining(int day, int *firstDay, int *lastDay) {
+    int y, m, d;
+    civilFromDays(day, &y, &m, &d);
+    *firstDay = daysFromCivil(y, m, 1);
+    *lastDay = (m == 12 ? daysFromCivil(y + 1, 1, 1) : daysFromCivil(y, m + 1, 1)) - 1;
+
+    if (payPeriodType == PAY_PERIOD_SEMI_MONTHLY) {
+        int cutoff = *firstDay + payPeriodCutoff - 1;
+        if (day <= cutoff) {
+            *lastDay = cutoff;
+        } else {
+            *firstDay = cutoff + 1;
+        }
+    }
+}
+
+
+
+
+
+
+
+
+// Finds the pay period containing today
+void currentPayPeriod(int *firstDay, int *lastDay) {
+    char date[11], timeBuf[6];
+    getCurrentDateTime(date, timeBuf);
+    payPeriodContaining(dateToDayNumber(date), firstDay, lastDay);
+}
+
+
+
+
+
+
+
+
+// Returns how many pay periods make up a month
+int payPeriodsPerMonth(void) {
+    return payPeriodType == PAY_PERIOD_SEMI_MONTHLY ? 2 : 1;
+}
+
+
+
+
+
+
+
+
+// Formats a pay period as "YYYY-MM-DD to YYYY-MM-DD" (text must hold 25 characters)
+void formatPayPeriod(int firstDay, int lastDay, char *text) {
+    formatDayNumber(firstDay, text);
+    strcpy(text + 10, " to ");
+    formatDayNumber(lastDay, text + 14);
+}
+
+
+
+
+
+
+
+
+// Switches to another pay period length; every employee's pay is recomputed next time
+void setPayPeriodType(PayPeriodType type) {
+    payPeriodType = type;
+    attendanceFoldedCount = -1;
+    for (int i = 0; i < employeeCount; i++) {
+        markPayrollInputChanged(i);
+    }
+}
+
+
+
+
+
+
+
+
+// Makes the month of day the active attendance partition if it is not already
+// Returns 1 if that month is active, 0 if the current month could not be saved
+int activatePartitionFor(int day) {
+    if (monthOfDay(day) == activePartitionMonth) return 1;
+    return switchAttendancePartition(monthOfDay(day));
+}
+
+
+
+
+
+
+
+
+// WRITE-BEHIND SAVES
+
+// Appends a change to the pending list, starting the save delay if it was empty
+void recordPendingChange(int empID, ChangeType type) {
+    if (pendingSaves.count == pendingSaves.capacity) {
+        int capacity = pendingSaves.capacity ? pendingSaves.capacity * 2 : 64;
+        PendingChange *grown = realloc(pendingSaves.changes, (size_t)capacity * sizeof(PendingChange));
+        if (!grown) {
+            // Cannot remember the change: persist everything right away instead
+            saveToFile();
+            return;
+        }
+        pendingSaves.changes = grown;
+        pendingSaves.capacity = capacity;
+    }
+    if (pendingSaves.count == 0) {
+        pendingSaves.firstChangeTime = time(NULL);
+    }
+    pendingSaves.changes[pendingSaves.count].empID = empID;
+    pendingSaves.changes[pendingSaves.count].type = type;
+    pendingSaves.count++;
+}
+
+
+
+
+
+
+
+
+// Marks an employee as changed so the next flush persists it
+void markEmployeeDirty(int slot) {
+    Employee *e = employeeAt(slot);
+    if (e->dirty) return;
+    e->dirty = 1;
+    recordPendingChange(e->empID, CHANGE_UPSERT);
+}
+
+
+
+
+
+
+
+
+// Records that an employee was removed so the next flush persists the removal
+void markEmployeeRemoved(int empID) {
+    recordPendingChange(empID, CHANGE_REMOVE);
+}
+
+
+
+
+
+
+
+
+// Forgets all pending changes after they have been persisted
+void clearPendingSaves(void) {
+    for (int i = 0; i < pendingSaves.count; i++) {
+        int slot = findEmployeeIndexByID(pendingSaves.changes[i].empID);
+        if (slot != -1) employeeAt(slot)->dirty = 0;
+    }
+    pendingSaves.count = 0;
+}
+
+
+
+
+
+
+
+
+// Writes one employee as a tab-separated upsert line of the payroll journal
+void writeEmployeeJournalLine(FILE *fp, const Employee *e) {
+    fprintf(fp, "U\t%d\t%s\t%s\t%.2f\t%d\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
+        e->empID,
+        e->name,
+        PositionNames[e->position],
+        PESOS(e->monthlySalary),
+        e->daysWorked,
+        e->totalOvertimeHours,
+        e->totalHoursWorked,
+        PESOS(e->lastOvertimePay),
+        PESOS(e->lastDailyRate),
+        PESOS(e->lastAbsentDeduct),
+        PESOS(e->lastGrossPay),
+        PESOS(e->lastNetPay),
+        PESOS(e->lastSSS),
+        PESOS(e->lastPhilHealth),
+        PESOS(e->lastPagIBIG),
+        PESOS(e->lastIncomeTax));
+}
+
+
+
+
+
+
+
+
+// Appends every pending change to the payroll journal with a single flush and fsync
+// Returns 1 on success, 0 on failure (the changes stay pending)
+int appendPayrollJournal(void) {
+    FILE *fp = fopen(PAYROLL_JOURNAL_FILE, "a");
+    if (!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    if (ftell(fp) == 0) {
+        fprintf(fp, "GEN %llu\n", payrollGeneration);
+    }
+
+    int written = 0;
+    for (int i = 0; i < pendingSaves.count; i++) {
+        const PendingChange *c = &pendingSaves.changes[i];
+        if (c->type == CHANGE_REMOVE) {
+            fprintf(fp, "R\t%d\n", c->empID);
+            written++;
+            continue;
+        }
+        int slot = findEmployeeIndexByID(c->empID);
+        if (slot == -1) continue;   // removed again before the flush; its R line follows
+        writeEmployeeJournalLine(fp, employeeAt(slot));
+        written++;
+    }
+    // The ID allocator's cursor, so IDs of employees removed since the snapshot stay retired
+    int nextID = employeeIDAllocator.next;
+    if (nextID != employeeIDAllocator.savedNext) fprintf(fp, "N\t%d\n", nextID);
+
+    int ok = fflush(fp) == 0 && FSYNC_FILE(fp) == 0;
+    if (fclose(fp) != 0) ok = 0;
+    if (ok) {
+        payrollJournalCount += written;
+        employeeIDAllocator.savedNext = nextID;
+    }
+    return ok;
+}
+
+
+
+
+
+
+
+
+// Re-applies the changes in the payroll journal on top of the loaded snapshot
+// A journal whose GEN line is older than the snapshot was already folded into it
+// Returns the number of changes applied
+int replayPayrollJournal(void) {
+    payrollJournalCount = 0;
+    FILE *fp = fopen(PAYROLL_JOURNAL_FILE, "r");
+    if (!fp) return 0;
+
+    rebuildEmployeeIDIndex();
+
+    int applied = 0;
+    int stale = 0;
+    char line[512];
+    unsigned long long journalGeneration;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "GEN %llu", &journalGeneration) == 1) {
+            stale = journalGeneration < payrollGeneration;
+            if (stale) break;
+            continue;
+        }
+        if (strchr(line, '\n') == NULL) break;    // torn last line
+        line[strcspn(line, "\r\n")] = 0;
+
+        char *fields[18];
+        int n = 0;
+        for (char *tok = strtok(line, "\t"); tok && n < 18; tok = strtok(NULL, "\t")) {
+            fields[n++] = tok;
+        }
+
+        if (n == 2 && strcmp(fields[0], "N") == 0) {
+            setNextEmployeeID(atoi(fields[1]));
+            continue;
+        } else if (n == 2 && strcmp(fields[0], "R") == 0) {
+            int slot = findEmployeeIndexByID(atoi(fields[1]));
+            if (slot == -1) continue;
+            idIndexRemove(employeeAt(slot)->empID);
+            if (slot != employeeCount - 1) {
+                *employeeAt(slot) = *employeeAt(employeeCount - 1);
+                idIndexPut(employeeAt(slot)->empID, slot);
+            }
+            employeeCount--;
+        } else if (n == 17 && strcmp(fields[0], "U") == 0) {
+            Employee e = {0};
+            e.empID = atoi(fields[1]);
+            snprintf(e.name, sizeof(e.name), "%s", fields[2]);
+            e.position = getPositionTypeByName(fields[3]);
+            e.monthlySalary = moneyFromPesos(atof(fields[4]));
+            e.daysWorked = atoi(fields[5]);
+            e.totalOvertimeHours = (float)atof(fields[6]);
+            e.totalHoursWorked = (float)atof(fields[7]);
+            e.lastOvertimePay = moneyFromPesos(atof(fields[8]));
+            e.lastDailyRate = moneyFromPesos(atof(fields[9]));
+            e.lastAbsentDeduct = moneyFromPesos(atof(fields[10]));
+            e.lastGrossPay = moneyFromPesos(atof(fields[11]));
+            e.lastNetPay = moneyFromPesos(atof(fields[12]));
+            e.lastSSS = moneyFromPesos(atof(fields[13]));
+            e.lastPhilHealth = moneyFromPesos(atof(fields[14]));
+            e.lastPagIBIG = moneyFromPesos(atof(fields[15]));
+            e.lastIncomeTax = moneyFromPesos(atof(fields[16]));
+
+            int slot = findEmployeeIndexByID(e.empID);
+            if (slot == -1) {
+                if (!storeReserve(&employeeStore, employeeCount + 1)) break;
+                slot = employeeCount++;
+                idIndexPut(e.empID, slot);
+            }
+            *employeeAt(slot) = e;
+        } else {
+            continue;
+        }
+        payrollJournalCount++;
+        applied++;
+    }
+    fclose(fp);
+
+    if (stale && !readOnlyMode) resetPayrollJournal();
+    return applied;
+}
+
+
+
+
+
+
+
+
+// Starts an empty payroll journal that extends the current payroll snapshot generation
+void resetPayrollJournal(void) {
+    char tmpPath[MAX_STR];
+    FILE *fp = beginAtomicWrite(PAYROLL_JOURNAL_FILE, tmpPath, sizeof(tmpPath), "w");
+    if (fp) {
+        fprintf(fp, "GEN %llu\n", payrollGeneration);
+        commitAtomicWrite(fp, tmpPath, PAYROLL_JOURNAL_FILE);
+    }
+    payrollJournalCount = 0;
+}
+
+
+
+
+
+
+
+
+// Persists pending employee changes when the write-behind policy says so (or when forced):
+// changed records are appended to the payroll journal, and a full save is only done when
+// the journal has grown past JOURNAL_COMPACT_THRESHOLD
+void flushPendingSaves(int force) {
+    if (pendingSaves.count == 0) return;
+    if (!force
+        && pendingSaves.count < SAVE_BATCH_SIZE
+        && time(NULL) - pendingSaves.firstChangeTime < SAVE_DELAY_SECONDS) return;
+
+    if (payrollJournalCount + pendingSaves.count >= JOURNAL_COMPACT_THRESHOLD) {
+        saveToFile();
+        return;
+    }
+    if (!appendPayrollJournal()) {
+        printStatus("\n\t\t\t\t\tError: Unable to append to %s. Saving full payroll file instead.\n", PAYROLL_JOURNAL_FILE);
+        saveToFile();
+        return;
+    }
+    clearPendingSaves();
+}
+
+
+
+
+
+
+
+
+// BINARY SNAPSHOTS
+
+// Maps a whole file read-only into memory
+// Returns 1 on success, 0 if the file does not exist or cannot be mapped
+int mapFile(const char *path, MappedFile *map) {
+    memset(map, 0, sizeof(*map));
+#ifdef _WIN32
+    map->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (map->file == INVALID_HANDLE_VALUE) return 0;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(map->file, &size) || size.QuadPart == 0) {
+        CloseHandle(map->file);
+        return 0;
+    }
+    map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!map->mapping) {
+        CloseHandle(map->file);
+        return 0;
+    }
+    map->data = MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!map->data) {
+        CloseHandle(map->mapping);
+        CloseHandle(map->file);
+        return 0;
+    }
+    map->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+    map->data = data;
+    map->size = (size_t)st.st_size;
+#endif
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Releases a mapping created by mapFile
+void unmapFile(MappedFile *map) {
+    if (!map->data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+    CloseHandle(map->file);
+#else
+    munmap(map->data, map->size);
+#endif
+    map->data = NULL;
+}
+
+
+
+
+
+
+
+
+// Folds a block of bytes into a running 64-bit checksum (FNV-1a over 8-byte words)
+unsigned long long snapshotChecksum(unsigned long long hash, const void *data, size_t size) {
+    const unsigned char *p = data;
+    while (size >= 8) {
+        unsigned long long word;
+        memcpy(&word, p, 8);
+        hash = (hash ^ word) * 0x100000001B3ull;
+        p += 8;
+        size -= 8;
+    }
+    while (size--) hash = (hash ^ *p++) * 0x100000001B3ull;
+    return hash;
+}
+
+
+
+
+
+
+
+
+// Writes count records of a chunked store as a binary snapshot
+// Returns 1 on success, 0 on any write error
+int writeSnapshot(const char *path, unsigned int kind, const ChunkedStore *store, int count,
+                  unsigned long long generation) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.recordSize = (unsigned int)store->recordSize;
+    if (kind == SNAPSHOT_KIND_EMPLOYEES) header.nextID = (unsigned int)employeeIDAllocator.next;
+    header.recordCount = (unsigned long long)count;
+    header.generation = generation;
+    header.checksum = 0xCBF29CE484222325ull;
+
+    int perChunk = 1 << store->chunkShift;
+    for (int done = 0; done < count; done += perChunk) {
+        int n = count - done < perChunk ? count - done : perChunk;
+        header.checksum = snapshotChecksum(header.checksum, storeAt(store, done), (size_t)n * store->recordSize);
+    }
+
+    char tmpPath[MAX_STR];
+    FILE *fp = beginAtomicWrite(path, tmpPath, sizeof(tmpPath), "wb");
+    if (!fp) return 0;
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    for (int done = 0; ok && done < count; done += perChunk) {
+        int n = count - done < perChunk ? count - done : perChunk;
+        ok = fwrite(storeAt(store, done), store->recordSize, (size_t)n, fp) == (size_t)n;
+    }
+    if (!ok) {
+        fclose(fp);
+        remove(tmpPath);
+        return 0;
+    }
+    return commitAtomicWrite(fp, tmpPath, path);
+}
+
+
+
+
+
+
+
+
+// Loads a binary snapshot into a chunked store, replacing its contents
+// Returns 1 if loaded, 0 if the file does not exist, -1 if it is damaged or incompatible
+int loadSnapshot(const char *path, unsigned int kind, ChunkedStore *store, int *count,
+                 unsigned long long *generation) {
+    MappedFile map;
+    if (!mapFile(path, &map)) return 0;
+
+    SnapshotHeader header;
+    int valid = map.size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, map.data, sizeof(header));
+        valid = memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+             && header.version == SNAPSHOT_VERSION
+             && header.kind == kind
+             && header.recordSize == store->recordSize
+             && header.recordCount <= 0x7FFFFFFF
+             && map.size == sizeof(header) + header.recordCount * header.recordSize;
+    }
+
+    const unsigned char *records = map.data + sizeof(header);
+    size_t bytes = valid ? (size_t)header.recordCount * header.recordSize : 0;
+    if (valid) {
+        valid = snapshotChecksum(0xCBF29CE484222325ull, records, bytes) == header.checksum;
+    }
+    if (!valid || !storeReserve(store, (int)header.recordCount)) {
+        unmapFile(&map);
+        return -1;
+    }
+
+    // Records are already in memory layout: copy them a whole chunk at a time
+    int total = (int)header.recordCount;
+    int perChunk = 1 << store->chunkShift;
+    for (int done = 0; done < total; done += perChunk) {
+        int n = total - done < perChunk ? total - done : perChunk;
+        memcpy(storeAt(store, done), records + (size_t)done * store->recordSize, (size_t)n * store->recordSize);
+    }
+    *count = total;
+    *generation = header.generation;
+    if (kind == SNAPSHOT_KIND_EMPLOYEES) setNextEmployeeID((int)header.nextID);
+
+    unmapFile(&map);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Writes the current employee and attendance data as binary snapshots and keeps using them
+void exportBinarySnapshots(void) {
+    compactAttendanceJournal();
+    useBinarySnapshots = 1;
+    saveToFile();
+    saveAttendanceToFile();
+}
+
+
+
+
+
+
+
+
+// Writes the current data back to the text files and stops using the binary snapshots
+// Earlier attendance months keep the format they were written in; both are read
+void exportTextFiles(void) {
+    useBinarySnapshots = 0;
+    saveToFile();
+    saveAttendanceToFile();
+    remove(BINARY_FILENAME);
+}
+
+
+
+
+
+
+
+
+// Displays the data file format menu and converts between text and binary snapshots
+void dataFilesMenu(void) {
+    clearScreen();
+    printf("\n\t\t\t\t                                        DATA FILE FORMAT\n");
+    printf("\n\t\t\t\t                                  Currently using: %s\n",
+           useBinarySnapshots ? "binary snapshots (" BINARY_FILENAME ", " ATTENDANCE_PARTITION_PREFIX "YYYY-MM.bin)"
+                              : "text files (" FILENAME ", " ATTENDANCE_PARTITION_PREFIX "YYYY-MM.txt)");
+    printf("\n\t\t\t\t                                        1. Export to binary snapshots\n");
+    printf("\t\t\t\t                                        2. Export back to text files\n");
+    printf("\t\t\t\t                                        3. Quiet mode (no animations or screen clears): %s\n",
+           quietMode ? "ON" : "OFF");
+    printf("\t\t\t\t                                        4. Pay period: %s", PayPeriodNames[payPeriodType]);
+    if (payPeriodType == PAY_PERIOD_SEMI_MONTHLY) printf(" (1-%d, %d-end of month)", payPeriodCutoff, payPeriodCutoff + 1);
+    printf("\n\t\t\t\t                                        5. Back\n");
+    int choice = getIntInput("\n\t\t\t\t                                          Choice: ", 1, 5);
+
+    if (choice == 1) {
+        exportBinarySnapshots();
+        printf("\n\t\t\t\t                    Saved %d employees and %d attendance records as binary snapshots.\n",
+               employeeCount, attendanceCount);
+    } else if (choice == 2) {
+        exportTextFiles();
+        printf("\n\t\t\t\t                    Saved %d employees and %d attendance records as text files.\n",
+               employeeCount, attendanceCount);
+    } else if (choice == 3) {
+        quietMode = !quietMode;
+        if (saveSettings()) {
+            printf("\n\t\t\t\t                    Quiet mode is now %s (saved in %s).\n", quietMode ? "ON" : "OFF", SETTINGS_FILE);
+        } else {
+            printf("\n\t\t\t\t                    Quiet mode is now %s, but %s could not be saved.\n",
+                   quietMode ? "ON" : "OFF", SETTINGS_FILE);
+        }
+    } else if (choice == 4) {
+        setPayPeriodType(payPeriodType == PAY_PERIOD_MONTHLY ? PAY_PERIOD_SEMI_MONTHLY : PAY_PERIOD_MONTHLY);
+        printf("\n\t\t\t\t                    Pay period is now %s%s; pay is recomputed on the next salary run.\n",
+               PayPeriodNames[payPeriodType], saveSettings() ? "" : " (settings could not be saved)");
+    }
+}
+
+
+
+
+
+
+
+
+// Appends printf-style text to buf at *len, advancing *len by the full formatted length
+// Output that does not fit is cut off, but *len still grows so the caller can detect it
+void appendFormat(char *buf, size_t size, size_t *len, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + (*len < size ? *len : size), *len < size ? size - *len : 0, fmt, args);
+    va_end(args);
+    if (n > 0) *len += (size_t)n;
+}
+
+
+
+
+
+
+
+
+// Renders an employee's payslip text into buf
+// Returns the slip's length; a result >= size means it did not fit and buf holds a partial slip
+size_t renderPaySlip(const Employee *e, char *buf, size_t size) {
+    size_t len = 0;
+    Money totalDeduction = e->lastSSS + e->lastPhilHealth + e->lastPagIBIG + e->lastIncomeTax;
+    Money actualBasicPay = e->lastDailyRate * e->daysWorked;
+
+    appendFormat(buf, size, &len, "================================================\n");
+    appendFormat(buf, size, &len, payPeriodType == PAY_PERIOD_SEMI_MONTHLY ? "      OFFICIAL SEMI-MONTHLY SALARY SLIP        \n"
+                                                                         : "         OFFICIAL MONTHLY SALARY SLIP          \n");
+    appendFormat(buf, size, &len, "================================================\n");
+    appendFormat(buf, size, &len, "Employee ID:               %d\n", e->empID);
+    appendFormat(buf, size, &len, "Employee Name:             %s\n", e->name);
+    appendFormat(buf, size, &len, "Position:                  %s\n", PositionNames[e->position]);
+    int standardDays = STANDARD_WORKING_DAYS / payPeriodsPerMonth();
+    if (foldedPeriodFirstDay >= 0) {
+        char period[25];
+        formatPayPeriod(foldedPeriodFirstDay, foldedPeriodLastDay, period);
+        appendFormat(buf, size, &len, "Pay Period:                %s\n", period);
+    }
+    appendFormat(buf, size, &len, "Fixed Monthly Salary Base: Php%.2f\n", PESOS(e->monthlySalary));
+    appendFormat(buf, size, &len, "Standard Working Days:     %d\n", standardDays);
+    appendFormat(buf, size, &len, "Daily Rate:                Php%.2f\n", PESOS(e->lastDailyRate));
+    appendFormat(buf, size, &len, "Days Worked:               %d\n", e->daysWorked);
+    if ((standardDays - e->daysWorked) > 0) {
+        appendFormat(buf, size, &len, "Days Absent:               %d\n", standardDays - e->daysWorked);
+    }
+    appendFormat(buf, size, &len, "------------------------------------------------\n");
+    appendFormat(buf, size, &len, "EARNINGS:\n");
+    appendFormat(buf, size, &len, "  - Basic Salary (Days Worked):    Php%.2f\n", PESOS(actualBasicPay));
+    // Overtime removed from slip 
+    if (e->lastAbsentDeduct > 0) {
+        appendFormat(buf, size, &len, "  - Less: Absent Deduction:         Php%.2f\n", PESOS(e->lastAbsentDeduct));
+    }
+    appendFormat(buf, size, &len, "GROSS PAY:                         Php%.2f\n", PESOS(e->lastGrossPay));
+    appendFormat(buf, size, &len, "------------------------------------------------\n");
+    appendFormat(buf, size, &len, "MANDATORY DEDUCTIONS:\n");
+    appendFormat(buf, size, &len, "  - SSS (4.5%%):                   Php%.2f\n", PESOS(e->lastSSS));
+    appendFormat(buf, size, &len, "  - PhilHealth (2.5%%):            Php%.2f\n", PESOS(e->lastPhilHealth));
+    appendFormat(buf, size, &len, "  - Pag-IBIG (2%%):                Php%.2f\n", PESOS(e->lastPagIBIG));
+    appendFormat(buf, size, &len, "  - Withholding Tax:               Php%.2f\n", PESOS(e->lastIncomeTax));
+    appendFormat(buf, size, &len, "------------------------------------------------\n");
+    appendFormat(buf, size, &len, "TOTAL DEDUCTIONS:                  Php%.2f\n", PESOS(totalDeduction));
+    appendFormat(buf, size, &len, "NET SALARY (Take Home):            Php%.2f\n", PESOS(e->lastNetPay));
+    appendFormat(buf, size, &len, "================================================\n");
+
+
+    return len;
+}
+
+
+
+
+
+
+
+
+// Writes payslip_<id>.txt for an employee into dir (NULL for the working directory)
+// Returns 1 on success; filename receives the path either way
+int writePaySlipFile(const Employee *e, const char *dir, char *filename, size_t filenameSize) {
+    if (dir && dir[0]) {
+        snprintf(filename, filenameSize, "%s/payslip_%d.txt", dir, e->empID);
+    } else {
+        snprintf(filename, filenameSize, "payslip_%d.txt", e->empID);
+    }
+
+    char slip[PAYSLIP_BUFFER_SIZE];
+    size_t len = renderPaySlip(e, slip, sizeof(slip));
+    if (len >= sizeof(slip)) return 0;
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp) return 0;
+    int ok = fwrite(slip, 1, len, fp) == len;
+    return fclose(fp) == 0 && ok;
+}
+
+
+
+
+
+
+
+
+// Generates and saves a payslip to a text file for a specific employee
+void printPaySlipToFile(const Employee *e) {
+    char filename[MAX_STR];
+    if (!writePaySlipFile(e, NULL, filename, sizeof(filename))) {
+        printf("\n\t\t\t\t                          ERROR: Unable to create file %s.\n", filename);
+        return;
+    }
+    printf("\n\t\t\t\t                          Salary Slip successfully saved to file: %s\n", filename);
+}
+
+
+
+
+
+
+
+
+// Worker body: renders one contiguous range of slips into their buffer slots
+WORKER_RETURN payslipWorker(void *arg) {
+    PayslipRange *range = (PayslipRange *)arg;
+    for (int i = range->first; i < range->last; i++) {
+        char *slot = range->buffer + (size_t)i * PAYSLIP_BUFFER_SIZE;
+        size_t len = renderPaySlip(employeeAt(range->slots[i]), slot, PAYSLIP_BUFFER_SIZE);
+        range->lengths[i] = len < PAYSLIP_BUFFER_SIZE ? len : 0;
+    }
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Writes the payslip of every employee whose payroll has been computed
+// With archivePath set, all slips go into that one file: a text index of "empID offset length"
+// lines (offsets counted from the end of the index) followed by the slips back to back;
+// otherwise each slip becomes payslip_<id>.txt in dir (NULL for the working directory)
+// Returns 1 on success, 0 if anything could not be written; *written receives the slip count
+int exportAllPayslips(const char *dir, const char *archivePath, int *written) {
+    *written = 0;
+    int *slots = malloc((size_t)(employeeCount ? employeeCount : 1) * sizeof(int));
+    size_t *lengths = malloc((size_t)(employeeCount ? employeeCount : 1) * sizeof(size_t));
+    char *buffer = malloc((size_t)(employeeCount ? employeeCount : 1) * PAYSLIP_BUFFER_SIZE);
+    if (!slots || !lengths || !buffer) {
+        free(slots);
+        free(lengths);
+        free(buffer);
+        return 0;
+    }
+
+    int count = 0;
+    for (int i = 0; i < employeeCount; i++) {
+        const Employee *e = employeeAt(i);
+        if (e->lastGrossPay == 0 && e->daysWorked == 0) continue;
+        slots[count++] = i;
+    }
+
+    // Render in parallel; worker 0 runs on the calling thread
+    int workers = countProcessors();
+    if (workers > MAX_PAYROLL_WORKERS) workers = MAX_PAYROLL_WORKERS;
+    if (count < PAYROLL_PARALLEL_THRESHOLD) workers = 1;
+    PayslipRange ranges[MAX_PAYROLL_WORKERS];
+    WorkerThread threads[MAX_PAYROLL_WORKERS];
+    int running[MAX_PAYROLL_WORKERS];
+    for (int w = 0; w < workers; w++) {
+        ranges[w].first = (int)((long long)count * w / workers);
+        ranges[w].last = (int)((long long)count * (w + 1) / workers);
+        ranges[w].slots = slots;
+        ranges[w].buffer = buffer;
+        ranges[w].lengths = lengths;
+    }
+    for (int w = 1; w < workers; w++) {
+        running[w] = startWorker(&threads[w], payslipWorker, &ranges[w]);
+        if (!running[w]) payslipWorker(&ranges[w]);
+    }
+    payslipWorker(&ranges[0]);
+    for (int w = 1; w < workers; w++) {
+        if (running[w]) joinWorker(threads[w]);
+    }
+
+    int ok = 1;
+    if (archivePath) {
+        // Pack the slips back to back so the whole body goes out in one write
+        size_t total = 0;
+        int packed = 0;
+        for (int i = 0; i < count; i++) {
+            if (lengths[i] == 0) {
+                ok = 0;
+                continue;
+            }
+            memmove(buffer + total, buffer + (size_t)i * PAYSLIP_BUFFER_SIZE, lengths[i]);
+            slots[packed] = slots[i];
+            lengths[packed++] = lengths[i];
+            total += lengths[i];
+        }
+
+        size_t indexSize = 64 + (size_t)packed * 48;
+        char *index = malloc(indexSize);
+        char tmpPath[MAX_STR];
+        FILE *fp = index ? beginAtomicWrite(archivePath, tmpPath, sizeof(tmpPath), "wb") : NULL;
+        if (!fp) {
+            ok = 0;
+        } else {
+            size_t len = 0;
+            size_t offset = 0;
+            appendFormat(index, indexSize, &len, "%s\n%d\n", PAYSLIP_ARCHIVE_MAGIC, packed);
+            for (int i = 0; i < packed; i++) {
+                appendFormat(index, indexSize, &len, "%d %lu %lu\n", employeeAt(slots[i])->empID,
+                             (unsigned long)offset, (unsigned long)lengths[i]);
+                offset += lengths[i];
+            }
+            int bodyOk = fwrite(index, 1, len, fp) == len && fwrite(buffer, 1, total, fp) == total;
+            if (commitAtomicWrite(fp, tmpPath, archivePath) && bodyOk) {
+                *written = packed;
+            } else {
+                ok = 0;
+            }
+        }
+        free(index);
+    } else {
+        char filename[512];
+        for (int i = 0; i < count; i++) {
+            const Employee *e = employeeAt(slots[i]);
+            if (dir && dir[0]) {
+                snprintf(filename, sizeof(filename), "%s/payslip_%d.txt", dir, e->empID);
+            } else {
+                snprintf(filename, sizeof(filename), "payslip_%d.txt", e->empID);
+            }
+
+            FILE *fp = lengths[i] ? fopen(filename, "w") : NULL;
+            if (!fp) {
+                ok = 0;
+                continue;
+            }
+            // A buffer the size of the slip turns the write into one system call
+            setvbuf(fp, NULL, _IOFBF, PAYSLIP_BUFFER_SIZE);
+            int slipOk = fwrite(buffer + (size_t)i * PAYSLIP_BUFFER_SIZE, 1, lengths[i], fp) == lengths[i];
+            if (fclose(fp) == 0 && slipOk) {
+                (*written)++;
+            } else {
+                ok = 0;
+            }
+        }
+    }
+
+    free(slots);
+    free(lengths);
+    free(buffer);
+    return ok;
+}
+
+
+
+
+
+
+
+
+// Exports every computed payslip at once, as separate files or as a single archive
+void bulkPayslipMenu(void) {
+    clearScreen();
+    printf("\n\t\t\t\t                                     EXPORT ALL SALARY SLIPS\n");
+    printf("\n\t\t\t\t                    1. One file per employee (payslip_<id>.txt)\n");
+    printf("\t\t\t\t                    2. Single archive (%s)\n", PAYSLIP_ARCHIVE_FILE);
+    printf("\t\t\t\t                    3. Back\n");
+    int choice = getIntInput("\n\t\t\t\t                                          Choice: ", 1, 3);
+    if (choice == 3) return;
+
+    int written = 0;
+    double start = wallClockMs();
+    int ok = exportAllPayslips(NULL, choice == 2 ? PAYSLIP_ARCHIVE_FILE : NULL, &written);
+    double seconds = (wallClockMs() - start) / 1000.0;
+
+    if (!ok) {
+        printf("\n\t\t\t\t                    ERROR: Some salary slips could not be written.\n");
+    }
+    printf("\n\t\t\t\t                    Exported %d salary slips in %.2f seconds.\n", written, seconds);
+    if (written == 0) {
+        printf("\t\t\t\t                    Run 'View Monthly Salary Computation' first.\n");
+    }
+}
+
+
+
+
+
+
+
+
+// ATTENDANCE SYSTEM 
+
+// Displays the attendance management menu and handles user choices
+void attendanceMenu(void) {
+    clearScreen();
+    int choice;
+    do {
+        printf("\n\t\t\t\t                                        ATTENDANCE MANAGEMENT\n");
+    printf("\n\t\t\t\t                                        1. Time In Today\n");
+    printf("\t\t\t\t                                        2. Absent\n");
+    printf("\t\t\t\t                                        3. BACK TO ADMIN MENU\n");
+    printf("\t\t\t\t                                        4. LIST EMPLOYEES BY ID (ascending)\n");
+    printf("\t\t\t\t                                        5. Compact Attendance Journal\n");
+    printf("\t\t\t\t                                        6. View Attendance by Month\n");
+        printf("\n\t\t\t\t                                          Choice: ");
+        
+        if (scanf("%d", &choice) != 1) {
+            printf("\n\t\t\t\t                                        Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+        
+        switch (choice) {
+            case 1: recordTimeIn(); break;
+            case 2: recordAbsent(); break;
+                case 3: printf("\n\t\t\t\t                                        Returning to Admin Menu.\n"); break;
+                case 4: viewEmployees(EMPLOYEE_ORDER_ID); break;
+                case 5: {
+                    char path[MAX_STR];
+                    compactAttendanceJournal();
+                    partitionPath(activePartitionMonth, useBinarySnapshots, path, sizeof(path));
+                    printf("\n\t\t\t\t                                        Attendance journal folded into %s.\n", path);
+                    break;
+                }
+                case 6: viewAttendanceHistory(); break;
+            default: printf("\n\t\t\t\t                                        Invalid choice. Please select 1-6.\n");
+        }
+        if (choice != 3) pressEnterToContinue();
+    } while (choice != 3);
+}
+
+// Records today's attendance for an employee, applying the same rules for every entry point:
+// a 7-digit ID of an existing employee with nothing recorded yet today
+// out receives the new record, or the existing one for PUNCH_ALREADY_RECORDED; the caller
+// journals a new record (the kiosk server batches many into one commit)
+PunchResult punchAttendance(int empID, AttendanceStatus status, AttendanceRecord *out) {
+    if (!isValidEmployeeID(empID)) return PUNCH_INVALID_ID;
+
+    int empIndex = findEmployeeIndexByID(empID);
+    if (empIndex == -1) return PUNCH_NOT_FOUND;
+
+    char currentDate[11], currentTime[6];
+    getCurrentDateTime(currentDate, currentTime);
+    int today = dateToDayNumber(currentDate);
+    activatePartitionFor(today);
+
+    int existing = dayIndexGet(empID, today);
+    if (existing != -1) {
+        *out = *attendanceAt(existing);
+        return PUNCH_ALREADY_RECORDED;
+    }
+
+    AttendanceRecord newRecord = {0};
+    newRecord.empID = empID;
+    newRecord.day = today;
+    newRecord.status = status;
+    newRecord.isLate = 0;
+    newRecord.overtimeHours = 0;
+    if (status == ATTENDANCE_PRESENT) {
+        newRecord.timeIn = (unsigned short)parseTimeOfDay(currentTime);
+        newRecord.hoursWorked = hoursToHundredths(8.0f);
+    }
+
+    if (appendAttendanceRecord(&newRecord) < 0) return PUNCH_NO_MEMORY;
+    markPayrollInputChanged(empIndex);
+    *out = newRecord;
+    return PUNCH_OK;
+}
+
+
+
+
+
+
+
+
+// Records a time-in entry for an employee with current date and time
+void recordTimeIn(void) {
+    clearScreen();
+    printf("\n\t\t\t\t                                        EMPLOYEE TIME IN\n");
+    
+    if (employeeCount == 0) {
+        printf("\t\t\t\t                                      No employees registered in the system.\n");
+        return;
+    }
+    
+    int empID;
+    printf("\t\t\t\t                             Enter Employee ID: ");
+    if (scanf("%d", &empID) != 1) {
+        printf("\t\t\t\t                                        Invalid ID format. Please enter numbers only.\n");
+        clearInputBuffer();
+        return;
+    }
+    clearInputBuffer();
+    
+    AttendanceRecord newRecord;
+    PunchResult result = punchAttendance(empID, ATTENDANCE_PRESENT, &newRecord);
+    if (result == PUNCH_INVALID_ID) {
+        printf("\t\t\t\t                     Employee ID. Must be 7 digits (1000000-9999999).\n");
+        return;
+    }
+    if (result == PUNCH_NOT_FOUND) {
+        printf("\t\t\t\t                                 Employee ID not found. Please check your ID and try again.\n");
+        return;
+    }
+    if (result == PUNCH_ALREADY_RECORDED) {
+        char existingTime[6];
+        formatTimeOfDay(newRecord.timeIn, existingTime);
+        printf("\t\t\t\t                                 You have already timed in today at %s.\n", existingTime);
+        return;
+    }
+    if (result == PUNCH_NO_MEMORY) {
+        printf("\t\t\t\t                     Out of memory. Cannot record time-in.\n");
+        return;
+    }
+    journalAttendanceRecord(&newRecord);
+
+    char currentDate[11], currentTime[6];
+    int empIndex = findEmployeeIndexByID(empID);
+    formatDayNumber(newRecord.day, currentDate);
+    formatTimeOfDay(newRecord.timeIn, currentTime);
+    
+    printf("\n\t\t\t\t                                  Time-In Recorded Successfully!\n");
+    printf("\t\t\t\t                                  Employee:      %s\n", employeeAt(empIndex)->name);
+    printf("\t\t\t\t                                  Date:          %s\n", currentDate);
+    printf("\t\t\t\t                                  Time-In:       %s\n", currentTime);
+    printf("\t\t\t\t                                  Status:        %s\n", AttendanceStatusNames[newRecord.status]);
+}
+
+// Records an absent entry for an employee
+void recordAbsent(void) {
+    clearScreen();
+    printf("\n\t\t\t\t                                        RECORD ABSENT\n");
+    
+    if (employeeCount == 0) {
+        printf("\t\t\t\t                           No employees registered in the system.\n");
+        return;
+    }
+    
+    int empID;
+    printf("\t\t\t\t                             Enter Employee ID: ");
+    if (scanf("%d", &empID) != 1) {
+        printf("\t\t\t\t                       Invalid ID format. Please enter numbers only.\n");
+        clearInputBuffer();
+        return;
+    }
+    clearInputBuffer();
+    
+    AttendanceRecord newRecord;
+    PunchResult result = punchAttendance(empID, ATTENDANCE_ABSENT, &newRecord);
+    if (result == PUNCH_INVALID_ID) {
+        printf("\t\t\t\t                Invalid Employee ID. Must be 7 digits (1000000-9999999).\n");
+        return;
+    }
+    if (result == PUNCH_NOT_FOUND) {
+        printf("\t\t\t\t\tEmployee ID not found. Please check your ID and try again.\n");
+        return;
+    }
+    if (result == PUNCH_ALREADY_RECORDED) {
+        printf("\t\t\t\t\tAttendance for this employee has already been recorded for today.\n");
+        return;
+    }
+    if (result == PUNCH_NO_MEMORY) {
+        printf("\t\t\t\t\tOut of memory. Cannot record absent.\n");
+        return;
+    }
+    journalAttendanceRecord(&newRecord);
+
+    char currentDate[11];
+    int empIndex = findEmployeeIndexByID(empID);
+    formatDayNumber(newRecord.day, currentDate);
+    
+    printf("\n\t\t\t\t\tAbsent Recorded Successfully!\n");
+    printf("\t\t\t\t\tEmployee:  %s\n", employeeAt(empIndex)->name);
+    printf("\t\t\t\t\tDate:      %s\n", currentDate);
+    printf("\t\t\t\t\tStatus:    Absent\n");
+}
+
+
+
+
+
+
+
+
+// Totals count attendance records of a store per employee in one pass
+// totals must hold employeeCount entries (indexed by employee slot); records of employees
+// who no longer exist are ignored
+void summarizeAttendance(const ChunkedStore *store, int count, AttendanceSummary *totals) {
+    memset(totals, 0, (size_t)employeeCount * sizeof(AttendanceSummary));
+
+    // Punches arrive in runs for the same employee often enough that remembering the
+    // last lookup saves most of the hash probes
+    int lastID = 0;
+    int lastSlot = -1;
+    for (int j = 0; j < count; j++) {
+        const AttendanceRecord *r = storeAt(store, j);
+        if (r->empID != lastID) {
+            lastID = r->empID;
+            lastSlot = findEmployeeIndexByID(r->empID);
+        }
+        if (lastSlot == -1) continue;
+
+        AttendanceSummary *t = &totals[lastSlot];
+        if (r->status == ATTENDANCE_PRESENT) {
+            t->daysWorked++;
+        } else if (r->status == ATTENDANCE_ABSENT) {
+            t->daysAbsent++;
+        }
+        t->overtimeHours += r->overtimeHours * 0.01f;
+    }
+}
+
+
+
+
+
+
+
+
+// Totals every employee's attendance for the current pay period, walking only that period's
+// run of the order index
+// summaries must hold employeeCount entries (indexed by employee slot) or be NULL;
+// each employee's daysWorked and totalOvertimeHours are refreshed from the totals
+// Returns 1 on success, 0 if memory could not be allocated
+int aggregateAttendance(AttendanceSummary *summaries) {
+    AttendanceSummary *totals = summaries;
+    if (!totals) {
+        totals = malloc((size_t)(employeeCount ? employeeCount : 1) * sizeof(AttendanceSummary));
+        if (!totals) return 0;
+    }
+    memset(totals, 0, (size_t)employeeCount * sizeof(AttendanceSummary));
+
+    int firstDay, lastDay;
+    currentPayPeriod(&firstDay, &lastDay);
+    activatePartitionFor(firstDay);
+    for (int j = orderIndexLowerBound(firstDay); j < attendanceOrderIndex.count; j++) {
+        const AttendanceRecord *r = attendanceAt(attendanceOrderIndex.records[j]);
+        if (r->day > lastDay) break;
+        int slot = findEmployeeIndexByID(r->empID);
+        if (slot == -1) continue;
+
+        AttendanceSummary *t = &totals[slot];
+        if (r->status == ATTENDANCE_PRESENT) {
+            t->daysWorked++;
+        } else if (r->status == ATTENDANCE_ABSENT) {
+            t->daysAbsent++;
+        }
+        t->overtimeHours += r->overtimeHours * 0.01f;
+    }
+
+    for (int i = 0; i < employeeCount; i++) {
+        Employee *e = employeeAt(i);
+        if (e->daysWorked != totals[i].daysWorked || e->totalOvertimeHours != totals[i].overtimeHours) {
+            e->daysWorked = totals[i].daysWorked;
+            e->totalOvertimeHours = totals[i].overtimeHours;
+            markPayrollInputChanged(i);
+            markEmployeeDirty(i);
+        }
+    }
+    attendanceFoldedCount = attendanceCount;
+    foldedPeriodFirstDay = firstDay;
+    foldedPeriodLastDay = lastDay;
+
+    if (totals != summaries) free(totals);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Adds attendance records appended since the last call to the employees' totals
+// Falls back to a full aggregateAttendance pass when the log was reloaded or compacted, or
+// when a new pay period has started
+// Returns 1 on success, 0 if memory could not be allocated
+int foldNewAttendance(void) {
+    int firstDay, lastDay;
+    currentPayPeriod(&firstDay, &lastDay);
+    if (attendanceFoldedCount < 0 || attendanceFoldedCount > attendanceCount || firstDay != foldedPeriodFirstDay) {
+        return aggregateAttendance(NULL);
+    }
+
+    int lastID = 0;
+    int lastSlot = -1;
+    for (int j = attendanceFoldedCount; j < attendanceCount; j++) {
+        const AttendanceRecord *r = attendanceAt(j);
+        if (r->day < firstDay || r->day > lastDay) continue;
+        if (r->empID != lastID) {
+            lastID = r->empID;
+            lastSlot = findEmployeeIndexByID(r->empID);
+        }
+        if (lastSlot == -1) continue;
+
+        Employee *e = employeeAt(lastSlot);
+        if (r->status == ATTENDANCE_PRESENT) e->daysWorked++;
+        e->totalOvertimeHours += r->overtimeHours * 0.01f;
+        markPayrollInputChanged(lastSlot);
+        markEmployeeDirty(lastSlot);
+    }
+    attendanceFoldedCount = attendanceCount;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Flags an employee's payroll as out of date so the next computation includes them
+void markPayrollInputChanged(int slot) {
+    employeeAt(slot)->changeGeneration++;
+}
+
+
+
+
+
+
+
+
+// Displays the current month's attendance summary for all employees with days worked and absent information
+void viewAttendance(void) {
+    clearScreen();
+    char monthText[8];
+    formatPartitionMonth(activePartitionMonth, monthText);
+    printf("\n\t\t\t               EMPLOYEE ATTENDANCE (%s)\n", monthText);
+    
+    if (employeeCount == 0) {
+        printf("\t\t\t               No employees registered in the system.\n");
+        return;
+    }
+    
+    AttendanceSummary *summaries = malloc((size_t)employeeCount * sizeof(AttendanceSummary));
+    if (!summaries || !aggregateAttendance(summaries)) {
+        printf("\t\t\t               Out of memory.\n");
+        free(summaries);
+        return;
+    }
+    printAttendanceSummary(summaries);
+    free(summaries);
+}
+
+
+
+
+
+
+
+
+// Prints the attendance table for every employee from per-slot totals
+void printAttendanceSummary(const AttendanceSummary *summaries) {
+    printf("\n\n\t\t\t               ========================================================================================\n");
+    printf("\t\t\t               | %-7s  %-35s  %-25s  %-10s  |\n", "ID", "Name", "Days Worked", "Absent");
+    printf("\t\t\t               ========================================================================================\n\n");
+    
+    for (int i = 0; i < employeeCount; i++) {
+        printf("\t\t\t                 %-7d  %-35s  %-25d  %-10d  \n\n",
+                employeeAt(i)->empID,
+                employeeAt(i)->name,
+                summaries[i].daysWorked,
+                summaries[i].daysAbsent);
+    }
+    printf("\t\t\t               ----------------------------------------------------------------------------------------\n");
+}
+
+
+
+
+
+
+
+
+// Displays the attendance summary of any month; an earlier month is read from its
+// partition file the first time it is asked for
+void viewAttendanceHistory(void) {
+    char monthText[MAX_STR];
+    getStringInput("\n\t\t\t\t                                        Month (YYYY-MM): ", monthText, sizeof(monthText), 0);
+    int month = parsePartitionMonth(monthText);
+    if (month < 0) {
+        printf("\n\t\t\t\t                                        Invalid month. Use YYYY-MM, e.g. 2025-03.\n");
+        return;
+    }
+    if (month == activePartitionMonth) {
+        viewAttendance();
+        return;
+    }
+
+    const ChunkedStore *store;
+    int count;
+    if (!attendanceForMonth(month, &store, &count)) {
+        printf("\n\t\t\t\t                                        No attendance recorded for %s.\n", monthText);
+        return;
+    }
+    if (employeeCount == 0) {
+        printf("\t\t\t               No employees registered in the system.\n");
+        return;
+    }
+    AttendanceSummary *summaries = malloc((size_t)employeeCount * sizeof(AttendanceSummary));
+    if (!summaries) {
+        printf("\t\t\t               Out of memory.\n");
+        return;
+    }
+    summarizeAttendance(store, count, summaries);
+
+    clearScreen();
+    printf("\n\t\t\t               EMPLOYEE ATTENDANCE (%s)\n", monthText);
+    printAttendanceSummary(summaries);
+    free(summaries);
+}
+
+
+
+
+
+
+
+
+// SALARY COMPUTATION 
+
+// Calculates income tax based on Philippine 2024 tax brackets
+Money calculateIncomeTax(Money taxableIncome) {
+    if (taxableIncome <= TAX_TIER_1_LIMIT) {
+        return 0;
+    } else if (taxableIncome <= TAX_TIER_2_LIMIT) {
+        return applyRate(taxableIncome - TAX_TIER_1_LIMIT, TAX_RATE_TIER_2);
+    } else if (taxableIncome <= TAX_TIER_3_LIMIT) {
+        return TAX_BASE_TIER_3 + applyRate(taxableIncome - TAX_TIER_2_LIMIT, TAX_RATE_TIER_3);
+    } else if (taxableIncome <= TAX_TIER_4_LIMIT) {
+        return TAX_BASE_TIER_4 + applyRate(taxableIncome - TAX_TIER_3_LIMIT, TAX_RATE_TIER_4);
+    } else if (taxableIncome <= TAX_TIER_5_LIMIT) {
+        return TAX_BASE_TIER_5 + applyRate(taxableIncome - TAX_TIER_4_LIMIT, TAX_RATE_TIER_5);
+    } else {
+        return TAX_BASE_TIER_6 + applyRate(taxableIncome - TAX_TIER_5_LIMIT, TAX_RATE_TIER_6);
+    }
+}
+
+
+
+
+
+
+
+
+// Computes one employee's pay for a pay period from their monthly salary and days worked in it
+// periodsPerMonth is 1 for monthly pay and 2 for semi-monthly pay (see PayPeriodType)
+// Pure function: no I/O and no globals; payrollKernel runs it for every row of the working set
+void computePayroll(Money monthlySalary, Money daysWorked, int periodsPerMonth, PayrollResult *out) {
+    // Calculate rates (daily rate rounded to the centavo; every amount below is a multiple of it)
+    Money dailyRate = (monthlySalary + STANDARD_WORKING_DAYS / 2) / STANDARD_WORKING_DAYS;
+    int standardDays = STANDARD_WORKING_DAYS / periodsPerMonth;
+
+    // Calculate Basic Pay (only for days actually worked)
+    Money basicSalary = dailyRate * daysWorked;
+    if (basicSalary < 0) basicSalary = 0;
+
+    Money absentDeduct = 0;
+    if (daysWorked < standardDays) {
+        absentDeduct = (standardDays - daysWorked) * dailyRate;
+    }
+
+    // Overtime removed
+    // Calculate Gross Pay without overtime (absent deduction already reflected in lower basicSalary)
+    Money grossPay = basicSalary;
+    if (grossPay < 0) grossPay = 0;
+
+    // Calculate mandatory deductions (only if grossPay is positive)
+    Money sssDeduct = 0;
+    Money philhealthDeduct = 0;
+    Money pagibigDeduct = 0;
+    Money incomeTaxDeduct = 0;
+
+    if (grossPay > 0) {
+        sssDeduct = applyRate(grossPay, DEDUCTION_SSS_RATE);
+        philhealthDeduct = applyRate(grossPay, DEDUCTION_PHILHEALTH_RATE);
+        pagibigDeduct = applyRate(grossPay, DEDUCTION_PAGIBIG_RATE);
+
+        // Calculate taxable income, as a monthly figure for the monthly tax table
+        Money taxableIncome = grossPay * periodsPerMonth;
+
+        // Calculate Income Tax, then this period's share of it
+        incomeTaxDeduct = (calculateIncomeTax(taxableIncome) + periodsPerMonth / 2) / periodsPerMonth;
+    }
+
+    // Final calculation
+    Money totalDeduction = sssDeduct + philhealthDeduct + pagibigDeduct + incomeTaxDeduct;
+    Money netSalary = grossPay - totalDeduction;
+    if (netSalary < 0) netSalary = 0;
+
+    out->dailyRate = dailyRate;
+    out->basicSalary = basicSalary;
+    out->absentDeduct = absentDeduct;
+    out->grossPay = grossPay;
+    out->sss = sssDeduct;
+    out->philHealth = philhealthDeduct;
+    out->pagIBIG = pagibigDeduct;
+    out->incomeTax = incomeTaxDeduct;
+    out->totalDeduction = totalDeduction;
+    out->netSalary = netSalary;
+}
+
+
+
+
+
+
+
+
+// Stores computed figures on the employee (only employees whose figures changed need saving)
+void applyPayrollResult(int slot, const PayrollResult *p) {
+    Employee *e = employeeAt(slot);
+    if (e->lastDailyRate != p->dailyRate || e->lastAbsentDeduct != p->absentDeduct
+        || e->lastOvertimePay != 0 || e->lastGrossPay != p->grossPay
+        || e->lastNetPay != p->netSalary || e->lastSSS != p->sss
+        || e->lastPhilHealth != p->philHealth || e->lastPagIBIG != p->pagIBIG
+        || e->lastIncomeTax != p->incomeTax) {
+        e->lastDailyRate = p->dailyRate;
+        e->lastAbsentDeduct = p->absentDeduct;
+        e->lastOvertimePay = 0;
+        e->lastGrossPay = p->grossPay;
+        e->lastNetPay = p->netSalary;
+        e->lastSSS = p->sss;
+        e->lastPhilHealth = p->philHealth;
+        e->lastPagIBIG = p->pagIBIG;
+        e->lastIncomeTax = p->incomeTax;
+        markEmployeeDirty(slot);
+    }
+}
+
+
+
+
+
+
+
+
+// Returns the number of online processors (at least 1)
+int countProcessors(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+
+
+
+
+
+
+
+// Starts a thread running fn(arg); returns 1 on success
+int startWorker(WorkerThread *thread, WORKER_RETURN (*fn)(void *), void *arg) {
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread != NULL;
+#else
+    return pthread_create(thread, NULL, fn, arg) == 0;
+#endif
+}
+
+
+
+
+
+
+
+
+// Waits for a thread started by startWorker to finish
+void joinWorker(WorkerThread thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+
+
+
+
+
+
+
+// Lets a thread started by startWorker clean up after itself when it finishes
+void detachWorker(WorkerThread thread) {
+#ifdef _WIN32
+    CloseHandle(thread);
+#else
+    pthread_detach(thread);
+#endif
+}
+
+
+
+
+
+
+
+
+// Prepares a signal one thread waits on and another raises; returns 1 on success
+int initWorkerSignal(WorkerSignal *signal) {
+#ifdef _WIN32
+    *signal = CreateEvent(NULL, FALSE, FALSE, NULL);
+    return *signal != NULL;
+#else
+    signal->raised = 0;
+    if (pthread_mutex_init(&signal->lock, NULL) != 0) return 0;
+    if (pthread_cond_init(&signal->cond, NULL) != 0) {
+        pthread_mutex_destroy(&signal->lock);
+        return 0;
+    }
+    return 1;
+#endif
+}
+
+
+
+
+
+
+
+
+// Wakes the thread waiting on a signal (or lets its next wait return at once)
+// The raising thread must not touch the waiter's data afterwards: it may already be reused
+void raiseWorkerSignal(WorkerSignal *signal) {
+#ifdef _WIN32
+    SetEvent(*signal);
+#else
+    pthread_mutex_lock(&signal->lock);
+    signal->raised = 1;
+    pthread_cond_signal(&signal->cond);
+    pthread_mutex_unlock(&signal->lock);
+#endif
+}
+
+
+
+
+
+
+
+
+// Sleeps until a signal is raised, then resets it for the next wait
+void waitWorkerSignal(WorkerSignal *signal) {
+#ifdef _WIN32
+    WaitForSingleObject(*signal, INFINITE);
+#else
+    pthread_mutex_lock(&signal->lock);
+    while (!signal->raised) pthread_cond_wait(&signal->cond, &signal->lock);
+    signal->raised = 0;
+    pthread_mutex_unlock(&signal->lock);
+#endif
+}
+
+
+
+
+
+
+
+
+// Sleeps until a signal is raised or ms milliseconds pass, then resets it for the next wait
+// Returns 1 if the signal was raised, 0 on timeout
+int waitWorkerSignalFor(WorkerSignal *signal, int ms) {
+#ifdef _WIN32
+    return WaitForSingleObject(*signal, (DWORD)ms) == WAIT_OBJECT_0;
+#else
+    // pthread_cond_timedwait takes a deadline on the realtime clock
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&signal->lock);
+    int waited = 0;
+    while (!signal->raised && waited == 0) {
+        waited = pthread_cond_timedwait(&signal->cond, &signal->lock, &deadline);
+    }
+    int raised = signal->raised;
+    signal->raised = 0;
+    pthread_mutex_unlock(&signal->lock);
+    return raised;
+#endif
+}
+
+
+
+
+
+
+
+
+// Releases a signal set up by initWorkerSignal
+void freeWorkerSignal(WorkerSignal *signal) {
+#ifdef _WIN32
+    CloseHandle(*signal);
+#else
+    pthread_cond_destroy(&signal->cond);
+    pthread_mutex_destroy(&signal->lock);
+#endif
+}
+
+
+
+
+
+
+
+
+// Allocates the working set for count employees and gathers their salary and days worked
+// Row r holds the employee in slot slots[r] (slot r when slots is NULL)
+// Returns 1 on success, 0 when out of memory
+int initPayrollColumns(PayrollColumns *cols, const int *slots, int count) {
+    int capacity = (count + PAYROLL_BLOCK - 1) / PAYROLL_BLOCK * PAYROLL_BLOCK;
+    if (capacity == 0) capacity = PAYROLL_BLOCK;
+
+    Money *block = calloc((size_t)capacity * PAYROLL_COLUMN_COUNT, sizeof(Money));
+    if (!block) return 0;
+
+    Money **columns[PAYROLL_COLUMN_COUNT] = {
+        &cols->monthlySalary, &cols->daysWorked, &cols->dailyRate, &cols->basicSalary,
+        &cols->absentDeduct, &cols->grossPay, &cols->sss, &cols->philHealth,
+        &cols->pagIBIG, &cols->incomeTax, &cols->totalDeduction, &cols->netSalary
+    };
+    for (int c = 0; c < PAYROLL_COLUMN_COUNT; c++) {
+        *columns[c] = block + (size_t)c * capacity;
+    }
+    cols->block = block;
+    cols->count = count;
+    cols->capacity = capacity;
+    cols->periodsPerMonth = payPeriodsPerMonth();
+
+    for (int i = 0; i < count; i++) {
+        const Employee *e = employeeAt(slots ? slots[i] : i);
+        cols->monthlySalary[i] = e->monthlySalary;
+        cols->daysWorked[i] = e->daysWorked;
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Releases the working set
+void freePayrollColumns(PayrollColumns *cols) {
+    free(cols->block);
+    cols->block = NULL;
+    cols->count = cols->capacity = 0;
+}
+
+
+
+
+
+
+
+
+// Computes rows [first, last) of the working set by running computePayroll on each row
+// The math is scalar; the gain is that only the columns used are streamed
+void payrollKernel(PayrollColumns *cols, int first, int last) {
+    for (int i = first; i < last; i++) {
+        PayrollResult r;
+        computePayroll(cols->monthlySalary[i], cols->daysWorked[i], cols->periodsPerMonth, &r);
+        cols->dailyRate[i] = r.dailyRate;
+        cols->basicSalary[i] = r.basicSalary;
+        cols->absentDeduct[i] = r.absentDeduct;
+        cols->grossPay[i] = r.grossPay;
+        cols->sss[i] = r.sss;
+        cols->philHealth[i] = r.philHealth;
+        cols->pagIBIG[i] = r.pagIBIG;
+        cols->incomeTax[i] = r.incomeTax;
+        cols->totalDeduction[i] = r.totalDeduction;
+        cols->netSalary[i] = r.netSalary;
+    }
+}
+
+
+
+
+
+
+
+
+// Copies row i of the working set into a PayrollResult
+void getPayrollColumnsRow(const PayrollColumns *cols, int i, PayrollResult *out) {
+    out->dailyRate = cols->dailyRate[i];
+    out->basicSalary = cols->basicSalary[i];
+    out->absentDeduct = cols->absentDeduct[i];
+    out->grossPay = cols->grossPay[i];
+    out->sss = cols->sss[i];
+    out->philHealth = cols->philHealth[i];
+    out->pagIBIG = cols->pagIBIG[i];
+    out->incomeTax = cols->incomeTax[i];
+    out->totalDeduction = cols->totalDeduction[i];
+    out->netSalary = cols->netSalary[i];
+}
+
+
+
+
+
+
+
+
+// Worker body: runs the kernel over one contiguous range of the working set
+// Each worker writes only its own rows, so no locking is needed
+WORKER_RETURN payrollWorker(void *arg) {
+    PayrollRange *range = (PayrollRange *)arg;
+    payrollKernel(range->columns, range->first, range->last);
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Computes payroll for count employees (see initPayrollColumns) into cols across the worker pool
+// Returns 1 on success, 0 when out of memory; the caller applies and prints the rows in
+// order, so output does not depend on thread timing (freePayrollColumns when done)
+int computePayrollColumns(PayrollColumns *cols, const int *slots, int count) {
+    if (!initPayrollColumns(cols, slots, count)) return 0;
+
+    int blocks = cols->capacity / PAYROLL_BLOCK;
+    int workers = countProcessors();
+    if (workers > MAX_PAYROLL_WORKERS) workers = MAX_PAYROLL_WORKERS;
+    if (workers > blocks) workers = blocks;
+    if (count < PAYROLL_PARALLEL_THRESHOLD) workers = 1;
+
+    PayrollRange ranges[MAX_PAYROLL_WORKERS];
+    WorkerThread threads[MAX_PAYROLL_WORKERS];
+    int running[MAX_PAYROLL_WORKERS];
+    for (int w = 0; w < workers; w++) {
+        ranges[w].first = (int)((long long)blocks * w / workers) * PAYROLL_BLOCK;
+        ranges[w].last = (int)((long long)blocks * (w + 1) / workers) * PAYROLL_BLOCK;
+        ranges[w].columns = cols;
+    }
+
+    // Worker 0 runs on the calling thread; a range whose thread fails to start is done inline too
+    for (int w = 1; w < workers; w++) {
+        running[w] = startWorker(&threads[w], payrollWorker, &ranges[w]);
+        if (!running[w]) payrollWorker(&ranges[w]);
+    }
+    payrollWorker(&ranges[0]);
+    for (int w = 1; w < workers; w++) {
+        if (running[w]) joinWorker(threads[w]);
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Recomputes payroll only for employees whose pay inputs changed since their last computation
+// Returns the number of employees recomputed, or -1 when out of memory
+int recomputeStalePayroll(void) {
+    if (!foldNewAttendance()) return -1;
+
+    int *slots = malloc((size_t)(employeeCount ? employeeCount : 1) * sizeof(int));
+    if (!slots) return -1;
+
+    int stale = 0;
+    for (int i = 0; i < employeeCount; i++) {
+        const Employee *e = employeeAt(i);
+        if (e->computedGeneration != e->changeGeneration) slots[stale++] = i;
+    }
+
+    PayrollColumns cols;
+    if (stale > 0 && !computePayrollColumns(&cols, slots, stale)) {
+        free(slots);
+        return -1;
+    }
+    // A few changed employees are moved within the net pay index; after a larger run it is
+    // cheaper to sort it again
+    int resort = stale > employeeCount / 8;
+    for (int r = 0; r < stale; r++) {
+        PayrollResult p;
+        getPayrollColumnsRow(&cols, r, &p);
+        Employee *e = employeeAt(slots[r]);
+        if (!resort && e->lastNetPay != p.netSalary) {
+            employeeIndexRemove(EMPLOYEE_ORDER_NET_PAY, slots[r]);
+            applyPayrollResult(slots[r], &p);
+            employeeIndexInsert(EMPLOYEE_ORDER_NET_PAY, slots[r]);
+        } else {
+            applyPayrollResult(slots[r], &p);
+        }
+        e->computedGeneration = e->changeGeneration;
+    }
+    if (resort) rebuildEmployeeIndex(EMPLOYEE_ORDER_NET_PAY);
+    if (stale > 0) freePayrollColumns(&cols);
+    free(slots);
+    return stale;
+}
+
+
+
+
+
+
+
+
+// Calculates and displays monthly salary computation for all employees
+void calculateAndDisplaySalary(void) {
+    clearScreen();
+    if (employeeCount == 0) {
+        printf("\n\t\t\t                                             No employees for salary computation.\n");
+        return;
+    }
+
+    int recomputed = recomputeStalePayroll();
+    if (recomputed < 0) {
+        printf("\n\t\t\t                                             Out of memory.\n");
+        return;
+    }
+
+    char period[25];
+    formatPayPeriod(foldedPeriodFirstDay, foldedPeriodLastDay, period);
+    printf("\n\t\t\t                            %s Salary Computation (Attendance Based)\n", PayPeriodNames[payPeriodType]);
+    printf("\t\t\t                                 (Pay period %s, %d Standard Working Days)\n\n",
+           period, STANDARD_WORKING_DAYS / payPeriodsPerMonth());
+
+    printf("\t\t                 ==================================================================================================\n");
+    printf("\t\t                 | %-7s %-20s    %-5s   %-10s   %-11s   %-10s   %-11s   |\n",  "ID", "Name", "Days", "Daily Rate", "Basic Salary", "Deductions", "Net Salary");
+    printf("\t\t                 ==================================================================================================\n");
+
+    for (int i = 0; i < employeeCount; i++) {
+        const Employee *e = employeeAt(i);
+        Money basicSalary = e->lastDailyRate * e->daysWorked;
+        Money totalDeduction = e->lastSSS + e->lastPhilHealth + e->lastPagIBIG + e->lastIncomeTax;
+
+        printf("\n\t\t                 %-7d   %-20s    %-5d   %-10.2f   %-11.2f    %-10.2f   %-11.2f \n\n",
+                e->empID, 
+                e->name, 
+                e->daysWorked,
+                PESOS(e->lastDailyRate),
+                PESOS(basicSalary), 
+                PESOS(totalDeduction),
+                PESOS(e->lastNetPay));
+    }
+    printf("\t\t                 --------------------------------------------------------------------------------------------------\n");
+    printf("\n\t\t\t                                  All salary computations for the period completed.\n");
+    printf("\t\t\t                                  (Results are saved with the next batch of changes, or on logout.)\n");
+    printf("\t\t\t                                  (%d of %d employees recomputed; the rest were unchanged.)\n",
+           recomputed, employeeCount);
+}
+
+
+
+
+
+
+
+
+// Displays a detailed salary slip for a specific employee
+void displayEmployeeSalarySlip(int id) {
+    clearScreen();
+    int idx = findEmployeeIndexByID(id);
+
+    if (idx == -1) {
+        printf("\n\t\t\t\t                                         Employee with ID %d not found.\n", id);
+        return;
+    }
+    
+    if (employeeAt(idx)->lastGrossPay == 0 && employeeAt(idx)->daysWorked == 0) {
+        printf("\n\t\t\t\t                              Salary computation has not been run for this employee yet.\n");
+        printf("\t\t\t\t                             Please run 'Calculate & View Monthly Salary Computation' first.\n");
+        return;
+    }
+
+    double started = wallClockMs();
+    if (!quietMode) {
+        printf("\n\t\t\t\t                          ==========================================\n");
+        printf("\t\t\t\t                                   GENERATING SALARY SLIP\n");
+        printf("\t\t\t\t                          ==========================================\n\n");
+        fflush(stdout);
+    
+        // Animated processing similar to Kali Linux install process
+        const char* stages[] = {
+            "processing",
+            "record system initializing",
+            "computation starting",
+            "deduction calculating"
+        };
+        int numStages = 4;
+        int stageDuration = 750; // 750ms per stage = 3 seconds total
+    
+        for (int stage = 0; stage < numStages; stage++) {
+            printf("\t\t\t\t                          [%d/%d] %s", stage + 1, numStages, stages[stage]);
+            fflush(stdout);
+        
+            // Animate dots
+            for (int dot = 0; dot < 15; dot++) {
+                printf(".");
+                fflush(stdout);
+                pauseMs(stageDuration / 15);
+            }
+        
+            printf(" [OK]\n");
+            fflush(stdout);
+        }
+    
+        printf("\n\t\t\t\t                          ==========================================\n");
+        printf("\t\t\t\t                            Salary Slip Generated Successfully!\n");
+        printf("\t\t\t\t                          ==========================================\n\n");
+        pauseMs(500);
+    }
+    
+    Employee e = *employeeAt(idx);
+
+    printf("\n\t\t\t\t                          ========= %s SALARY SLIP =========\n",
+           payPeriodType == PAY_PERIOD_SEMI_MONTHLY ? "SEMI-MONTHLY" : "MONTHLY");
+    printf("\t\t\t\t                          Employee ID:           %d\n", e.empID);
+    printf("\t\t\t\t                          Employee Name:         %s\n", e.name);
+    printf("\t\t\t\t                          Position:              %s\n", PositionNames[e.position]);
+    if (foldedPeriodFirstDay >= 0) {
+        char period[25];
+        formatPayPeriod(foldedPeriodFirstDay, foldedPeriodLastDay, period);
+        printf("\t\t\t\t                          Pay Period:            %s\n", period);
+    }
+    printf("\t\t\t\t                          Monthly Salary Base:   Php%.2f\n", PESOS(e.monthlySalary));
+    printf("\t\t\t\t                          Daily Rate:            Php%.2f\n", PESOS(e.lastDailyRate));
+    printf("\t\t\t\t                          Days Worked:           %d / %d\n", e.daysWorked, STANDARD_WORKING_DAYS / payPeriodsPerMonth());
+    printf("\t\t\t\t                          -----------------------------------------\n");
+
+    Money totalDeduction = e.lastSSS + e.lastPhilHealth + e.lastPagIBIG + e.lastIncomeTax;
+    Money actualBasicPay = e.lastDailyRate * e.daysWorked;
+    if (actualBasicPay < 0) actualBasicPay = 0;
+
+    printf("\t\t\t\t                          EARNINGS:\n"); 
+    printf("\t\t\t\t                          - Basic Salary (Days Worked):   Php%.2f\n", PESOS(actualBasicPay));
+    // Overtime removed from slip
+    if (e.lastAbsentDeduct > 0 && e.daysWorked < STANDARD_WORKING_DAYS / payPeriodsPerMonth()) {
+        printf("\t\t\t\t                          - Less: Absent Deduction:        Php%.2f\n", PESOS(e.lastAbsentDeduct)); 
+    }
+    printf("\t\t\t\t                          -----------------------------------------\n");
+    printf("\t\t\t\t                          TOTAL GROSS PAY:                 Php%.2f\n", PESOS(e.lastGrossPay)); 
+    printf("\t\t\t\t                          -----------------------------------------\n");
+    printf("\t\t\t\t                          DEDUCTIONS:\n");
+    printf("\t\t\t\t                          - SSS (4.5%%):              Php%.2f\n", PESOS(e.lastSSS));
+    printf("\t\t\t\t                          - PhilHealth (2.5%%):       Php%.2f\n", PESOS(e.lastPhilHealth));
+    printf("\t\t\t\t                          - Pag-IBIG (2%%):           Php%.2f\n", PESOS(e.lastPagIBIG));
+    printf("\t\t\t\t                          - Income Tax:              Php%.2f\n", PESOS(e.lastIncomeTax));
+    printf("\t\t\t\t                          -----------------------------------------\n");
+    printf("\t\t\t\t                          TOTAL DEDUCTIONS:          Php%.2f\n", PESOS(totalDeduction));
+    printf("\t\t\t\t                          NET SALARY:                Php%.2f\n", PESOS(e.lastNetPay));
+    printf("\t\t\t\t                          =========================================\n");
+
+    printf("\t\t\t\t                          (slip ready in %.2f ms%s)\n", wallClockMs() - started,
+           quietMode ? ", quiet mode" : "");
+
+    printf("\n\t\t\t\t               Do you want to print this salary slip to a text file? (Y/N): ");
+    char choice = 'N';
+    if (scanf(" %c", &choice) != 1) choice = 'N';
+    clearInputBuffer();
+
+    if (choice == 'Y' || choice == 'y') {
+        printPaySlipToFile(&e);
+    }
+}
+
+
+
+
+
+
+
+
+// Employee Management
+
+// Displays a list of all employees in the system in the given order
+void viewEmployees(EmployeeOrder order) {
+    clearScreen();
+    if (employeeCount == 0) {
+        printf("\n\t\t\t\t                                   There is no employees yet.\n");
+        return;
+    }
+
+    printf("\n\n\t\t\t                 %d EMPLOYEE RECORDS (by %s)\n", employeeCount, EmployeeOrderNames[order]);
+    printf("\t\t\t               ========================================================================================\n");
+    // Listed by net pay, the last column shows the pay they are sorted by
+    int showNetPay = order == EMPLOYEE_ORDER_NET_PAY;
+    printf("\t\t\t               | %-8s   %-30s   %-22s  %-14s   |\n", "ID", "Name", "Position",
+           showNetPay ? "Last Net Pay" : "Monthly Base");
+    printf("\t\t\t               ========================================================================================\n");
+
+    const EmployeeSortIndex *index = &employeeSortIndexes[order];
+    for (int i = 0; i < index->count; i++) {
+        const Employee *e = employeeAt(index->slots[i]);
+        printf("\n\t\t\t                 %-8d   %-30s   %-22s   Php%-11.2f  \n",
+                e->empID,
+                e->name,
+                PositionNames[e->position],
+                PESOS(showNetPay ? e->lastNetPay : e->monthlySalary));
+    }
+    printf("\n\n\t\t\t               ----------------------------------------------------------------------------------------\n");
+}
+
+
+
+
+
+
+
+
+// Lists employees in the given order from now on (the records themselves are not moved)
+void setEmployeeListOrder(EmployeeOrder order) {
+    employeeListOrder = order;
+    printf("\n\t\t\t\t                    Employees are now listed by %s%s.\n", EmployeeOrderNames[order],
+           saveSettings() ? "" : " (settings could not be saved)");
+}
+
+
+
+
+
+
+
+
+// Lists the employees whose name starts with the text entered (case-insensitive)
+void searchEmployeesByName(void) {
+    clearScreen();
+    if (employeeCount == 0) {
+        printf("\n\t\t\t\t                                   There is no employees yet.\n");
+        return;
+    }
+
+    char prefix[50];
+    printf("\n\t\t\t\t                                     FIND EMPLOYEE BY NAME\n");
+    getStringInput("\n\t\t\t\t                  Enter a name or the start of one: ", prefix, sizeof(prefix), 0);
+
+    int first;
+    int found = findEmployeesByNamePrefix(prefix, &first);
+    if (found == 0) {
+        printf("\n\t\t\t\t                          No employee name starts with '%s'.\n", prefix);
+        return;
+    }
+
+    printf("\n\n\t\t\t                 %d EMPLOYEE%s MATCHING '%s'\n", found, found == 1 ? "" : "S", prefix);
+    printf("\t\t\t               ========================================================================================\n");
+    printf("\t\t\t               | %-8s   %-30s   %-22s  %-14s   |\n", "ID", "Name", "Position", "Monthly Base");
+    printf("\t\t\t               ========================================================================================\n");
+
+    const EmployeeSortIndex *index = &employeeSortIndexes[EMPLOYEE_ORDER_NAME];
+    for (int i = first; i < first + found; i++) {
+        const Employee *e = employeeAt(index->slots[i]);
+        printf("\n\t\t\t                 %-8d   %-30s   %-22s   Php%-11.2f  \n",
+                e->empID,
+                e->name,
+                PositionNames[e->position],
+                PESOS(e->monthlySalary));
+    }
+    printf("\n\n\t\t\t               ----------------------------------------------------------------------------------------\n");
+}
+
+
+
+
+
+
+
+
+// Adds a new employee to the system
+void addEmployee(void) {
+    clearScreen();
+    if (!storeReserve(&employeeStore, employeeCount + 1) || !employeeIndexesReserve(employeeCount + 1)) {
+        printf("\n\t\t\t\t\tOut of memory. Cannot add more employees.\n");
+        return;
+    }
+
+    Employee e;
+    printf("\n\t\t\t\t                                        ADD NEW EMPLOYEE\n");
+    
+    e.empID = generateEmployeeID();
+    if (e.empID == 0) {
+        printf("\n\t\t\t\t\tEvery employee ID is already taken. Cannot add more employees.\n");
+        return;
+    }
+    printf("\t\t\t                                         Generated Employee ID: %d\n", e.empID);
+    
+    // Get name with duplicate validation
+    char name[50];
+    while (1) {
+        getStringInput("\n\t\t\t\t                             Enter Full Name: ", name, sizeof(name), 1);
+        
+        if (findEmployeeIndexByName(name) != -1) {
+            printf("\t\t\t\t                    Employee with name '%s' already exists!\n", name);
+            printf("\t\t\t\t                                   Please enter a different person.\n");
+            continue;
+        }
+        break;
+    }
+    strcpy(e.name, name);
+
+    printf("\n\t\t\t\t                                         SELECT POSITION\n");
+    for (int i = 0; i < NUM_POSITIONS; i++) {
+        printf("\t\t\t\t                           %d. %s       Php%.2f per month\n",   i + 1, PositionNames[i],       PESOS(PositionMonthlySalaries[i]));
+    }
+    int posChoice = getIntInput("\n\n\t\t\t\t                                          Choice: ", 1, NUM_POSITIONS);
+
+
+
+
+
+    e.position = (PositionType)(posChoice - 1);
+    e.monthlySalary = PositionMonthlySalaries[e.position];
+    
+    e.daysWorked = 0;
+
+    // Initialize all calculation fields
+    e.totalOvertimeHours = 0.0f;
+    e.totalHoursWorked = 0.0f;
+    e.lastOvertimePay = 0;
+    e.lastDailyRate = 0;
+    e.lastAbsentDeduct = 0;
+    e.lastGrossPay = 0;
+    e.lastNetPay = 0;
+    e.lastSSS = 0;
+    e.lastPhilHealth = 0;
+    e.lastPagIBIG = 0;
+    e.lastIncomeTax = 0;
+    e.dirty = 0;
+    e.changeGeneration = 1;
+    e.computedGeneration = 0;
+
+    printf("\n\t\t\t\t                                         EMPLOYEE DETAIL\n");
+    printf("\n\t\t\t\t                                  ID:                %d\n", e.empID);
+    printf("\t\t\t\t                                  Name:              %s\n", e.name);
+    printf("\t\t\t\t                                  Position:          %s\n", PositionNames[e.position]);
+    printf("\t\t\t\t                                  Monthly Salary:    Php%.2f\n", PESOS(e.monthlySalary));
+    
+    printf("\n\t\t\t\t\tConfirm Add? (Y to confirm, any other key to cancel): ");
+    char c = 'N';
+    if (scanf(" %c", &c) != 1) c = 'N';
+    clearInputBuffer();
+
+    if (c == 'Y' || c == 'y') {
+        storeNewEmployee(&e);
+        flushPendingSaves(1);
+        printf("\n\t\t\t\t                    Employee '%s' added successfully with ID: %d.\n", e.name, e.empID);
+    } else {
+        returnEmployeeID(e.empID);
+        printf("\n\t\t\t\t                                Adding cancelled. No changes made.\n");
+    }
+}
+
+
+
+
+
+
+
+
+// Updates an existing employee's information
+void updateEmployee(void) {
+    clearScreen();
+    if (employeeCount == 0) {
+        printf("\n\t\t\t\t                                There is no employees yet to update.\n");
+        return;
+    }
+    printf("\n\t\t\t\t                                        UPDATE EMPLOYEE\n");
+    
+    int id;
+    printf("\n\t\t\t\t                             Enter Employee ID to update: ");
+    if (scanf("%d", &id) != 1) {
+        printf("\t\t\t\t                             Invalid ID format.\n");
+        clearInputBuffer();
+        return;
+    }
+    clearInputBuffer();
+    
+    if (!isValidEmployeeID(id)) {
+        printf("\t\t\t\t                                Invalid Employee ID. Must be 7 digits.\n");
+        return;
+    }
+    
+    int idx = findEmployeeIndexByID(id);
+
+    if (idx == -1) {
+        printf("\n\t\t\t\t                                Employee with ID %d not found.\n", id);
+        return;
+    }
+
+    Employee *e = employeeAt(idx);
+    Employee old = *e;
+
+    printf("\n\t\t\t\t                                  Current Employee Details\n");
+    printf("\t\t\t\t                                  Name:        %s\n", e->name);
+    printf("\t\t\t\t                                  Position:    %s (Php%.2f/month)\n", PositionNames[e->position], PESOS(e->monthlySalary));
+    printf("\t\t\t\t                                  Days Worked: %d\n", e->daysWorked);
+
+    printf("\n\t\t\t\t                                Which field do you want to update?\n");
+    printf("\t\t\t\t                                1) Name\n");
+    printf("\t\t\t\t                                2) Position and Monthly Salary\n");
+    printf("\t\t\t\t                                3) Back\n");
+    int choice = getIntInput("\t\t\t\t                                          Choice: ", 1, 3);
+
+    if (choice == 3) {
+        printf("\n\t\t\t\t                              Update cancelled.\n");
+        return;
+    }
+
+    switch (choice) {
+        case 1: {
+            char newName[50];
+            while (1) {
+                getStringInput("\n\t\t\t\t                             Enter new full name: ", newName, sizeof(newName), 1);
+                
+                if (isNameDuplicate(newName, e->empID)) {
+                    printf("\t\t\t\t                    The Employee with name '%s' already exists!\n", newName);
+                    printf("\t\t\t\t                    Sorry you can't add the same person.\n");
+                    continue;
+                }
+                break;
+            }
+            if (strcmp(e->name, newName) == 0) {
+                printf("\t\t\t\t                         New name is the same as current name. Update cancelled.\n");
+                return;
+            }
+            strcpy(e->name, newName);
+            printf("\t\t\t\t                                 Name updated to: %s\n", e->name);
+            break;
+        }
+        case 2: {
+            printf("\n\t\t\t\t                                  SELECT NEW POSITION\n");
+            for (int i = 0; i < NUM_POSITIONS; i++) {
+                printf("\t\t\t\t                                  %d. %s (Php%.2f per month)\n",
+                        i + 1, PositionNames[i], PESOS(PositionMonthlySalaries[i]));
+            }
+            int posChoice = getIntInput("\t\t\t\t                                          Choice: ", 1, NUM_POSITIONS);
+            PositionType newPosition = (PositionType)(posChoice - 1);
+            if (e->position == newPosition) {
+                printf("\t\t\t\t                         New position is the same as current position. Update cancelled.\n");
+                return;
+            }
+            e->position = newPosition;
+            e->monthlySalary = PositionMonthlySalaries[e->position];
+            printf("\n\t\t\t\t                    Position updated to %s (Php%.2f/month).\n", PositionNames[e->position], PESOS(e->monthlySalary));
+            break;
+        }
+    }
+
+    printf("\t\t\t\t                    Confirm update? (Y to confirm, any other key to cancel): ");
+    char c = 'N';
+    if (scanf(" %c", &c) != 1) c = 'N';
+    clearInputBuffer();
+
+    if (c == 'Y' || c == 'y') {
+        // The sort indexes still hold the old record's place; move it to the new one
+        Employee updated = *e;
+        *e = old;
+        updateEmployeeRecord(idx, &updated);
+        markPayrollInputChanged(idx);
+        markEmployeeDirty(idx);
+        flushPendingSaves(1);
+        printf("\n\t\t\t\t                             Employee updated and saved successfully.\n");
+    } else {
+        *e = old;
+        printf("\n\t\t\t\t                            Update cancelled; original record restored.\n");
+    }
+}
+
+
+
+
+
+
+
+
+// Removes an employee from the system
+void removeEmployee(void) {
+    clearScreen();
+    if (employeeCount == 0) {
+        printf("\n\t\t\t\t                                There is no employees yet to remove.\n");
+        pressEnterToContinue();
+        return;
+    }
+    
+    printf("\n\t\t\t\t                                        REMOVE EMPLOYEE\n");
+    
+    int id;
+    while (1) {
+        printf("\n\t\t\t\t                        Enter Employee ID to remove (or 0 to cancel): ");
+        if (scanf("%d", &id) != 1) {
+            printf("\t\t\t\t                                Invalid ID format. Please enter numbers only.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+        
+        if (id == 0) {
+            printf("\n\t\t\t\t                                Remove operation cancelled.\n");
+            return;
+        }
+        
+        if (!isValidEmployeeID(id)) {
+            printf("\t\t\t\t                                Invalid Employee ID. Must be 7 digits.\n");
+            continue;
+        }
+        
+        int idx = findEmployeeIndexByID(id);
+        if (idx == -1) {
+            printf("\t\t\t\t                   Employee with ID %d not found. Please enter a valid ID.\n", id);
+            continue;
+        }
+        break;
+    }
+    
+    int idx = findEmployeeIndexByID(id);
+    printf("\n\t\t\t\t                                   EMPLOYEE TO BE REMOVED\n");
+    printf("\t\t\t\t                                  ID:              %d\n", employeeAt(idx)->empID);
+    printf("\t\t\t\t                                  Name:            %s\n", employeeAt(idx)->name);
+    printf("\t\t\t\t                                  Position:        %s\n", PositionNames[employeeAt(idx)->position]);
+    printf("\t\t\t\t                                  Monthly Salary:  Php%.2f\n", PESOS(employeeAt(idx)->monthlySalary));
+    
+    printf("\n\t\t\t\t                       ARE YOU SURE YOU WANT TO REMOVE THIS EMPLOYEE?\n");
+    printf("\t\t\t\t    This action cannot be undone! (Type 'REMOVE' to confirm, any other key to cancel): ");
+    
+    char confirmation[10];
+    if (!fgets(confirmation, sizeof(confirmation), stdin)) {
+        printf("\n\t\t\t\t\tRemoval cancelled. No changes made.\n");
+        pressEnterToContinue();
+        return;
+    }
+    
+    confirmation[strcspn(confirmation, "\n")] = 0;
+    
+    if (strcmp(confirmation, "REMOVE") == 0) {
+        char deletedName[50];
+        strcpy(deletedName, employeeAt(idx)->name);
+        int deletedID = employeeAt(idx)->empID;
+        
+        // Remove employee from array, moving the last employee into the freed slot
+        idIndexRemove(deletedID);
+        removeFromEmployeeIndexes(idx);
+        if (idx != employeeCount - 1) {
+            *employeeAt(idx) = *employeeAt(employeeCount - 1);
+            idIndexPut(employeeAt(idx)->empID, idx);
+            renumberInEmployeeIndexes(employeeCount - 1, idx);
+        }
+        --employeeCount;
+        
+        // Remove attendance records for this employee
+        for (int i = 0; i < attendanceCount; i++) {
+            if (attendanceAt(i)->empID == deletedID) attendanceAt(i)->empID = 0;
+        }
+        removeClearedAttendanceRecords();
+        
+        markEmployeeRemoved(deletedID);
+        flushPendingSaves(1);
+        saveAttendanceToFile();
+        
+        // The ID may be given to a new employee only once no month still holds its records
+        if (purgeEmployeeAttendance(deletedID)) {
+            releaseEmployeeID(deletedID);
+        } else {
+            printf("\n\t\t\t\t\tWarning: Unable to remove this employee's attendance from earlier months.\n");
+        }
+        
+        printf("\n\t\t\t\t\tEmployee '%s' (ID: %d) Removed successfully.\n", deletedName, deletedID);
+    } else {
+        printf("\n\t\t\t\t\tRemoval cancelled. No changes made.\n");
+    }
+    
+    pressEnterToContinue();
+}
+
+
+
+
+
+
+
+
+// ADMIN AND MAIN MENU
+
+// Verifies admin PIN for accessing admin functions
+int verifyPin(void) {
+    int pin;
+    int attempts = 3;
+    
+    while (attempts > 0) {
+        clearScreen();
+        printf("\n\t\t\t\t                                    %d Attempts remaining ", attempts);
+        printf("\n\n\t\t\t\t                                   Enter Admin PIN (0000): ");
+        if (scanf("%d", &pin) != 1) {
+            clearInputBuffer();
+            printf("\t\t\t\t                             Invalid input. Please enter numbers only.\n");
+            attempts--;
+            continue;
+        }
+        clearInputBuffer();
+        if (pin == ADMIN_PIN) {
+            printf("\n\t\t\t\t                                          Login successful.\n");
+            return 1;
+        } else {
+            printf("\t\t\t\t                                          Login failed.\n");
+            attempts--;
+        }
+    }
     
-    Employee e = employees[idx];
+    printf("\n\t\t\t\t                             Too many failed attempts. Access denied.\n");
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Displays and handles the admin control panel menu
+void adminMenu(void) {
+    clearScreen();
+    int choice;
+    do {
+        printf("\n\n\t\t\t\t                                        ADMIN CONTROL PANEL                \n");
+        printf("\n\n\t\t\t\t                                        - RECORD  SYSTEM -                      \n");
+        printf("\t\t\t\t                                    1. VIEW ALL EMPLOYEE RECORD               \n");
+        printf("\t\t\t\t                                    2. ADD    NEW      EMPLOYEE                    \n");
+        printf("\t\t\t\t                                    3. UPDATE  EMPLOYEE  DETAIL                  \n");
+        printf("\t\t\t\t                                    4. REMOVE          EMPLOYEE                       \n");
+        printf("\t\t\t\t                                    5. EMPLOYEE SORTING OPTIONS                         \n");
+        printf("\t\t\t\t                                    13. FIND EMPLOYEE BY NAME                        \n");
+        printf("\n\n\t\t\t\t                                        - ATTENDANCE RECORD -                   \n");
+        printf("\t\t\t\t                                    6. ATTENDANCE     DASHBOARD                     \n");
+        printf("\t\t\t\t                                    7. VIEW          ATTENDANCE                       \n");
+        printf("\n\n\t\t\t\t                                       - SALARY COMPUTATION -                            \n");
+        printf("\t\t\t\t                                    8. VIEW MONTHLY SALARY COMPUTATION            \n");
+        printf("\t\t\t\t                                    9. GENERATE  SLIP   BY   ID                       \n");
+        printf("\t\t\t\t                                    12. EXPORT ALL SALARY SLIPS                      \n");
+        printf("\n\n\t\t\t\t                                        - DATA FILES -                            \n");
+        printf("\t\t\t\t                                    11. DATA FILE FORMAT (TEXT / BINARY)              \n");
+    printf("\n\t\t\t\t                                    10. BACK     TO    MAIN MENU                              \n");
+        printf("\n\n\t\t\t\t                                          Choice: ");
+
+        if (scanf("%d", &choice) != 1) {
+            printf("\n\t\t\t\t                             2.   Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+
+        switch (choice) {
+            case 1: viewEmployees(employeeListOrder);              break;
+            case 2: addEmployee();                break;
+            case 3: updateEmployee();             break;
+            case 4: removeEmployee();             break;
+            case 5: {
+                int sortChoice = 0;
+                do {
+                    clearScreen();
+                    printf("\n\t\t\t\t                                        EMPLOYEE SORTING OPTIONS\n");
+                    printf("\t\t\t\t                                        Listed by: %s\n", EmployeeOrderNames[employeeListOrder]);
+                    printf("\t\t\t\t                                        1. Sort by ID\n");
+                    printf("\t\t\t\t                                        2. Sort by Name\n");
+                    printf("\t\t\t\t                                        3. Sort by Position\n");
+                    printf("\t\t\t\t                                        4. Sort by Net Pay (highest first)\n");
+                    printf("\t\t\t\t                                        5. Back\n");
+                    sortChoice = getIntInput("\n\t\t\t\t                                          Choice: ", 1, 5);
+                    if (sortChoice != 5) {
+                        setEmployeeListOrder((EmployeeOrder)(sortChoice - 1));
+                        pressEnterToContinue();
+                        viewEmployees(employeeListOrder);
+                        pressEnterToContinue();
+                    }
+                } while (sortChoice != 5);
+                break;
+            }
+            case 6: attendanceMenu();             break;
+            case 7: viewAttendance(); break;
+            case 8: calculateAndDisplaySalary();  break;
+            case 9: {
+                int id = getIntInput("\n\t\t\t\t                                Enter Employee ID for Salary Slip: ", MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID);
+                displayEmployeeSalarySlip(id);
+                break;
+            }
+            case 10: printf("\n\t\t\t\t                             2.   Logging out of Admin.\n"); break;
+            case 11: dataFilesMenu(); break;
+            case 12: bulkPayslipMenu(); break;
+            case 13: searchEmployeesByName(); break;
+            default: printf("\n\t\t\t\t                             2.   Invalid choice. Please select 1-13.\n");
+        }
+        flushPendingSaves(0);
+        if (choice != 9) pressEnterToContinue();
+    } while (choice != 9);
+    flushPendingSaves(1);
+}
+
+
+
+
+
+
+
+
+// Displays and handles the main menu of the system
+void mainMenu(void) {
+    int choice;
+    do {
+        clearScreen();
+        printf("\n\n\n\t\t\t    ** ** **  ** **      ** **  ** ** **   **           ** ** **      **        **    ** ** **    ** ** **     \n");
+        printf("\t\t\t    **        **  **    **  **  **     **  **         **        **     **      **     **          **                 \n");
+        printf("\t\t\t    **        **   **  **   **  **     **  **        **          **     **    **      **          **                 \n");
+        printf("\t\t\t    ** ** **  **     **     **  ** ** **   **        **          **      **  **       ** ** **    ** ** **           \n");
+        printf("\t\t\t    **        **            **  **         **        **          **        **         **          **                 \n");
+        printf("\t\t\t    **        **            **  **         **        **          **        **         **          **                 \n");
+        printf("\t\t\t    **        **            **  **         **         **        **         **         **          **                 \n");
+        printf("\t\t\t    ** ** **  **            **  **         ** ** **     ** ** **           **         ** ** **    ** ** **           \n");
+        printf("\n\t\t\t\t                                       RECORD SYSTEM           \n\n");
+        printf("\n\n\t\t\t\t                             1.         ADMIN LOGIN           ");
+        printf("\n\n\t\t\t\t                             2.   VIEW ALL EMPLOYEE RECORDS     ");
+        printf("\n\n\t\t\t\t                             3.         EXIT SYSTEM             ");
+        printf("\n\n\n\t\t\t\t                                          Choice: ");
+
+        if (scanf("%d", &choice) != 1) {
+            printf("\n\t\t\t\t                             Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+
+        clearInputBuffer();
+
+        switch (choice) {
+            case 1:
+                if (verifyPin()) adminMenu();
+                else pressEnterToContinue();
+                break;
+            case 2:
+                viewEmployees(employeeListOrder);
+                pressEnterToContinue();
+                break;
+            case 3:
+                printf("\n\t\t\t\t                            Exiting system. All changes saved.\n");
+                break;
+            default:
+                printf("\n\t\t\t\t                            Invalid choice. Please select 1-3.\n");
+                pressEnterToContinue();
+        }
+    } while (choice != 3);
+}
+
+
+
+
+
+
+
+
+// KIOSK SERVER
+
+// Resets a punch queue to empty (head and tail both at the stub node)
+void punchQueueInit(PunchQueue *q) {
+    atomic_store(&q->stub.next, NULL);
+    atomic_store(&q->head, &q->stub);
+    q->tail = &q->stub;
+}
+
+
+
+
+
+
+
+
+// Adds an event to the queue; safe to call from any number of threads at once
+void punchQueuePush(PunchQueue *q, PunchEvent *e) {
+    atomic_store_explicit(&e->next, NULL, memory_order_relaxed);
+    PunchEvent *prev = atomic_exchange_explicit(&q->head, e, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, e, memory_order_release);
+}
+
+
+
+
+
+
+
+
+// Takes the oldest event off the queue, or returns NULL if none is ready
+// Only the main thread may call this
+PunchEvent *punchQueuePop(PunchQueue *q) {
+    PunchEvent *tail = q->tail;
+    PunchEvent *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (tail == &q->stub) {
+        if (!next) return NULL;
+        q->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+
+    // tail is the last node: a producer may be mid-push, otherwise re-insert the stub behind it
+    if (tail != atomic_load_explicit(&q->head, memory_order_acquire)) return NULL;
+    punchQueuePush(q, &q->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+
+
+
+
+
+
+
+// SIGINT/SIGTERM handler: asks the server loop to stop after the current event
+void handleStopSignal(int sig) {
+    (void)sig;
+    atomic_store(&kioskStopRequested, 1);
+}
+
+
+
+
+
+
+
+
+// Applies one queued punch with punchAttendance and writes the reply line for its client
+// A recorded punch adds its journal line to batch and returns 1: the caller acknowledges it
+// once the batch is committed. Rejected punches return 0 and can be acknowledged at once.
+int processPunchEvent(PunchEvent *e, char *batch, size_t *batchLen) {
+    AttendanceRecord r = {0};
+    PunchResult result = punchAttendance(e->empID, e->status, &r);
+    char date[11], timeBuf[6];
+    formatDayNumber(r.day, date);
+    formatTimeOfDay(r.timeIn, timeBuf);
+
+    switch (result) {
+        case PUNCH_OK:
+            snprintf(e->reply, sizeof(e->reply), "OK %d %s %s %s\n",
+                     e->empID, date, timeBuf, AttendanceStatusNames[r.status]);
+            break;
+        case PUNCH_INVALID_ID:
+            snprintf(e->reply, sizeof(e->reply), "ERR invalid ID (must be 7 digits)\n");
+            break;
+        case PUNCH_NOT_FOUND:
+            snprintf(e->reply, sizeof(e->reply), "ERR employee %d not found\n", e->empID);
+            break;
+        case PUNCH_ALREADY_RECORDED:
+            snprintf(e->reply, sizeof(e->reply), "ERR already recorded today (%s %s)\n",
+                     AttendanceStatusNames[r.status], r.status == ATTENDANCE_PRESENT ? timeBuf : "");
+            break;
+        default:
+            snprintf(e->reply, sizeof(e->reply), "ERR out of memory\n");
+            break;
+    }
+    if (result != PUNCH_OK) return 0;
+    e->day = r.day;
+    *batchLen += formatJournalLine(&r, batch + *batchLen, JOURNAL_LINE_SIZE);
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Takes back recorded punches whose batch could not be committed, so memory holds only what
+// is durable: a retried punch is recorded afresh and nothing unsaved is written at exit
+void withdrawPunches(PunchEvent **events, int count) {
+    for (int i = 0; i < count; i++) {
+        int record = dayIndexGet(events[i]->empID, events[i]->day);
+        if (record != -1) attendanceAt(record)->empID = 0;
+        int slot = findEmployeeIndexByID(events[i]->empID);
+        if (slot != -1) markPayrollInputChanged(slot);
+    }
+    removeClearedAttendanceRecords();
+}
+
+
+
+
+
+
+
+
+// Formats the group commit counters as a single line
+void formatGroupCommitStats(char *buf, size_t size) {
+    long long commits = atomic_load(&journalCommits);
+    long long punches = atomic_load(&journalCommittedPunches);
+    snprintf(buf, size, "commits=%lld punches=%lld avg_batch=%.2f max_batch=%lld sizes[1,2-4,5-16,17-64,65+]=%lld,%lld,%lld,%lld,%lld",
+             commits, punches, commits ? (double)punches / commits : 0.0, atomic_load(&journalLargestCommit),
+             atomic_load(&journalCommitsBySize[0]), atomic_load(&journalCommitsBySize[1]),
+             atomic_load(&journalCommitsBySize[2]), atomic_load(&journalCommitsBySize[3]),
+             atomic_load(&journalCommitsBySize[4]));
+}
+
+
+
+
+
+
+
+
+// Client thread: reads request lines, queues each punch and writes back the reply
+// Lines are "IN <id>", "ABSENT <id>", "STATS" or "QUIT"; "SHUTDOWN" stops the server
+WORKER_RETURN kioskClientWorker(void *arg) {
+    SocketHandle client = (SocketHandle)(size_t)arg;
+    char buf[512];
+    int used = 0;
+    WorkerSignal replied;
+    if (!initWorkerSignal(&replied)) {
+        CLOSE_SOCKET(client);
+        return 0;
+    }
+    atomic_fetch_add(&kioskClients, 1);
+
+    for (;;) {
+        int n = (int)recv(client, buf + used, (int)(sizeof(buf) - 1 - used), 0);
+        if (n <= 0) break;
+        used += n;
+        buf[used] = 0;
+
+        char *line = buf;
+        char *newline;
+        int quit = 0;
+        while (!quit && (newline = strchr(line, '\n')) != NULL) {
+            *newline = 0;
+            if (newline > line && newline[-1] == '\r') newline[-1] = 0;
+
+            char command[16];
+            int empID = 0;
+            const char *reply = NULL;
+            PunchEvent e;
+            int fields = sscanf(line, "%15s %d", command, &empID);
+            if (fields >= 1 && strcmp(command, "QUIT") == 0) {
+                quit = 1;
+            } else if (fields >= 1 && strcmp(command, "STATS") == 0) {
+                char stats[sizeof(e.reply) - 8];
+                formatGroupCommitStats(stats, sizeof(stats));
+                snprintf(e.reply, sizeof(e.reply), "OK %s\n", stats);
+                reply = e.reply;
+            } else if (fields >= 1 && strcmp(command, "SHUTDOWN") == 0) {
+                atomic_store(&kioskStopRequested, 1);
+                raiseWorkerSignal(&punchQueueSignal);
+                reply = "OK shutting down\n";
+                quit = 1;
+            } else if (fields == 2 && (strcmp(command, "IN") == 0 || strcmp(command, "ABSENT") == 0)) {
+                e.empID = empID;
+                e.status = strcmp(command, "IN") == 0 ? ATTENDANCE_PRESENT : ATTENDANCE_ABSENT;
+                e.done = &replied;
+
+                double started = wallClockMs();
+                punchQueuePush(&punchQueue, &e);
+                raiseWorkerSignal(&punchQueueSignal);
+                // e is on this stack and linked into the queue, so wait for the reply however long it takes
+                waitWorkerSignal(&replied);
+                long long micros = (long long)((wallClockMs() - started) * 1000.0);
+                atomic_fetch_add(&kioskAckCount, 1);
+                atomic_fetch_add(&kioskAckMicros, micros);
+                long long maxMicros = atomic_load(&kioskAckMaxMicros);
+                while (micros > maxMicros && !atomic_compare_exchange_weak(&kioskAckMaxMicros, &maxMicros, micros)) {}
+                reply = e.reply;
+            } else if (line[0]) {
+                reply = "ERR expected IN <id>, ABSENT <id>, STATS, QUIT or SHUTDOWN\n";
+            }
+            if (reply) send(client, reply, (int)strlen(reply), 0);
+            line = newline + 1;
+        }
+        if (quit) break;
+
+        // Keep any partial line for the next recv; drop a line too long to ever complete
+        used = (int)strlen(line);
+        memmove(buf, line, (size_t)used + 1);
+        if (used >= (int)sizeof(buf) - 1) used = 0;
+    }
+
+    CLOSE_SOCKET(client);
+    freeWorkerSignal(&replied);
+    atomic_fetch_sub(&kioskClients, 1);
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Accept thread: hands every new connection to its own client thread
+WORKER_RETURN kioskAcceptWorker(void *arg) {
+    SocketHandle listener = (SocketHandle)(size_t)arg;
+    while (!atomic_load(&kioskStopRequested)) {
+        SocketHandle client = accept(listener, NULL, NULL);
+        if (client == INVALID_SOCKET) continue;
+
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, (const char *)&noDelay, sizeof(noDelay));
+        WorkerThread thread;
+        if (startWorker(&thread, kioskClientWorker, (void *)(size_t)client)) {
+            detachWorker(thread);
+        } else {
+            CLOSE_SOCKET(client);
+        }
+    }
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Runs the kiosk server on 127.0.0.1:port until SHUTDOWN, SIGINT or SIGTERM
+// The calling thread is the only one that touches the attendance store: it drains the punch
+// queue and sleeps on punchQueueSignal whenever the queue is empty
+// Returns the process exit code
+int serveKiosk(int port) {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        fprintf(stderr, "serve: unable to start Winsock\n");
+        return 1;
+    }
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    SocketHandle listener = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((unsigned short)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int reuse = 1;
+    if (listener != INVALID_SOCKET) {
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+    }
+    if (listener == INVALID_SOCKET || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0
+        || listen(listener, 64) != 0) {
+        fprintf(stderr, "serve: unable to listen on 127.0.0.1:%d\n", port);
+        if (listener != INVALID_SOCKET) CLOSE_SOCKET(listener);
+        return 1;
+    }
+
+    // Recorded punches wait in held (their journal lines in batch) until the group commit
+    int batchLimit = groupCommitBatch < 1 ? 1 : groupCommitBatch > GROUP_COMMIT_MAX_BATCH ? GROUP_COMMIT_MAX_BATCH : groupCommitBatch;
+    PunchEvent **held = malloc((size_t)batchLimit * sizeof(PunchEvent *));
+    char *batch = malloc((size_t)batchLimit * JOURNAL_LINE_SIZE);
+    if (!held || !batch || !initWorkerSignal(&punchQueueSignal)) {
+        fprintf(stderr, "serve: out of memory\n");
+        free(held);
+        free(batch);
+        CLOSE_SOCKET(listener);
+        return 1;
+    }
+
+    punchQueueInit(&punchQueue);
+    atomic_store(&kioskStopRequested, 0);
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+
+    WorkerThread acceptThread;
+    if (!startWorker(&acceptThread, kioskAcceptWorker, (void *)(size_t)listener)) {
+        fprintf(stderr, "serve: unable to start the accept thread\n");
+        free(held);
+        free(batch);
+        freeWorkerSignal(&punchQueueSignal);
+        CLOSE_SOCKET(listener);
+        return 1;
+    }
+    detachWorker(acceptThread);
+    printf("Kiosk server listening on 127.0.0.1:%d (send SHUTDOWN or press Ctrl+C to stop).\n", port);
+    fflush(stdout);
+
+    int heldCount = 0;
+    size_t batchLen = 0;
+    double oldestHeld = 0.0;
+
+    long long processed = 0;
+    int draining = 0;
+    for (;;) {
+        PunchEvent *e = punchQueuePop(&punchQueue);
+        if (e) {
+            processed++;
+            if (processPunchEvent(e, batch, &batchLen)) {
+                if (heldCount == 0) oldestHeld = wallClockMs();
+                held[heldCount++] = e;
+            } else {
+                raiseWorkerSignal(e->done);
+            }
+        }
+
+        int commit = heldCount == batchLimit
+                  || (heldCount > 0 && !e && (draining || wallClockMs() - oldestHeld >= groupCommitDelayMs));
+        if (commit) {
+            // Punches are acknowledged only once durable; otherwise they are withdrawn and the
+            // kiosk is told to retry
+            int durable = 0;
+            for (int attempt = 0; attempt < GROUP_COMMIT_ATTEMPTS && !durable; attempt++) {
+                durable = commitAttendanceJournal(batch, batchLen, heldCount);
+            }
+            if (!durable) withdrawPunches(held, heldCount);
+            for (int i = 0; i < heldCount; i++) {
+                if (!durable) snprintf(held[i]->reply, sizeof(held[i]->reply), "ERR not saved\n");
+                raiseWorkerSignal(held[i]->done);
+            }
+            heldCount = 0;
+            batchLen = 0;
+            continue;
+        }
+        if (e) continue;
+
+        // Queue empty: after a stop request, finish once nothing is queued or mid-push
+        if (atomic_load(&kioskStopRequested)) {
+            draining = 1;
+            if (heldCount == 0 && atomic_load(&punchQueue.head) == &punchQueue.stub) break;
+            YIELD_THREAD();
+        } else {
+            // Sleep until a client queues a punch, or until the held batch is due
+            int waitMs = KIOSK_STOP_CHECK_MS;
+            if (heldCount > 0) {
+                double due = oldestHeld + groupCommitDelayMs - wallClockMs();
+                if (due < waitMs) waitMs = due < 1.0 ? 1 : (int)ceil(due);
+            }
+            waitWorkerSignalFor(&punchQueueSignal, waitMs);
+        }
+    }
+    free(held);
+    free(batch);
+    freeWorkerSignal(&punchQueueSignal);
+    CLOSE_SOCKET(listener);
+
+    long long acks = atomic_load(&kioskAckCount);
+    printf("Kiosk server stopped: %lld punches processed", processed);
+    if (acks > 0) {
+        printf(", ack latency avg %.3f ms, max %.3f ms", atomic_load(&kioskAckMicros) / 1000.0 / acks,
+               atomic_load(&kioskAckMaxMicros) / 1000.0);
+    }
+    printf(".\n");
+    char stats[256];
+    formatGroupCommitStats(stats, sizeof(stats));
+    printf("Journal group commits: %s\n", stats);
+    return 0;
+}
+
+
+
+
+
+
+
+
+// CSV IMPORT AND EXPORT
+
+// Opens a CSV file for csvReadRow; returns 1 on success, 0 if it cannot be read
+int csvOpen(CsvReader *reader, const char *path) {
+    memset(reader, 0, sizeof(*reader));
+    reader->fp = fopen(path, "rb");
+    if (!reader->fp) return 0;
+    reader->buffer = malloc(CSV_CHUNK_SIZE + 1);
+    if (!reader->buffer) {
+        fclose(reader->fp);
+        return 0;
+    }
+    reader->nextLine = 1;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Closes a reader opened by csvOpen
+void csvClose(CsvReader *reader) {
+    if (reader->fp) fclose(reader->fp);
+    free(reader->buffer);
+    reader->fp = NULL;
+    reader->buffer = NULL;
+}
+
+
+
+
+
+
+
+
+// Splits the next row into fields (at most maxFields are stored; quotes and "" escapes are
+// undone in place). The fields stay valid until the next call.
+// Returns the number of fields in the row, -1 at the end of the file, or CSV_ROW_TOO_LONG for
+// a row that does not fit in the buffer (it is skipped)
+int csvReadRow(CsvReader *reader, char **fields, int maxFields) {
+    char *buf = reader->buffer;
+    size_t rowEnd;
+    int lines = 0, tooLong = 0;
+    while (1) {
+        // Look for the end of the row: a newline outside quotes
+        int inQuotes = 0;
+        lines = 0;
+        for (rowEnd = reader->start; rowEnd < reader->end; rowEnd++) {
+            char c = buf[rowEnd];
+            if (c == '"' && !tooLong) inQuotes = !inQuotes;
+            else if (c == '\n' && !inQuotes) break;
+            else if (c == '\n') lines++;
+        }
+        if (rowEnd < reader->end || (reader->eof && rowEnd > reader->start)) break;
+        if (reader->eof) {
+            if (!tooLong) return -1;
+            break;
+        }
+
+        if (reader->start == 0 && reader->end == CSV_CHUNK_SIZE) {
+            // The row fills the whole buffer: drop it and keep reading to its end
+            tooLong = 1;
+            reader->end = 0;
+        }
+        memmove(buf, buf + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+        size_t n = fread(buf + reader->end, 1, CSV_CHUNK_SIZE - reader->end, reader->fp);
+        reader->end += n;
+        if (n == 0) reader->eof = 1;
+    }
+
+    char *row = buf + reader->start;
+    reader->lineNo = reader->nextLine;
+    reader->nextLine += lines + 1;
+    reader->start = rowEnd < reader->end ? rowEnd + 1 : rowEnd;
+    if (tooLong) return CSV_ROW_TOO_LONG;
+    buf[rowEnd] = '\0';
+    if (rowEnd > 0 && buf[rowEnd - 1] == '\r' && row < buf + rowEnd) buf[rowEnd - 1] = '\0';
+
+    int count = 0;
+    char *p = row;
+    while (1) {
+        char *field = p;
+        char *out = p;
+        if (*p == '"') {
+            p++;
+            while (*p) {
+                if (*p == '"') {
+                    if (p[1] != '"') {
+                        p++;
+                        break;
+                    }
+                    p++;
+                }
+                *out++ = *p++;
+            }
+            while (*p && *p != ',') p++;    // anything between the closing quote and the comma is dropped
+        } else {
+            while (*p && *p != ',') p++;
+            out = p;
+        }
+        char separator = *p;
+        *out = '\0';
+        if (count < maxFields) fields[count] = field;
+        count++;
+        if (separator != ',') break;
+        p++;
+    }
+    return count;
+}
+
+
+
+
+
+
+
+
+// Writes text as a CSV field, quoting it when it contains a comma, quote or line break
+void writeCsvField(FILE *fp, const char *text) {
+    if (!strpbrk(text, ",\"\r\n")) {
+        fputs(text, fp);
+        return;
+    }
+    fputc('"', fp);
+    for (; *text; text++) {
+        if (*text == '"') fputc('"', fp);
+        fputc(*text, fp);
+    }
+    fputc('"', fp);
+}
+
+
+
+
+
+
+
+
+// Parses a whole field as a number within [min, max]; returns 1 on success
+int parseCsvNumber(const char *text, double min, double max, double *value) {
+    char *end;
+    double v = strtod(text, &end);
+    if (end == text) return 0;
+    while (isspace((unsigned char)*end)) end++;
+    if (*end || v != v || v < min || v > max) return 0;
+    *value = v;
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Adds imported attendance records for months other than the active one to their partition
+// files, one merge per month (records are sorted in place)
+// Returns the number of records that could not be written
+int mergeImportedAttendance(AttendanceRecord *records, int count, int *imported, int *duplicates) {
+    int failed = 0;
+    // Sorting by day groups the punches into one run per month
+    qsort(records, (size_t)count, sizeof(AttendanceRecord), compareAttendanceRecords);
+    for (int first = 0; first < count; ) {
+        int month = monthOfDay(records[first].day);
+        int last = first + 1;
+        while (last < count && monthOfDay(records[last].day) == month) last++;
+
+        int skipped;
+        int added = mergeAttendancePartition(month, records + first, last - first, &skipped);
+        if (added < 0) {
+            char partition[MAX_STR];
+            partitionPath(month, useBinarySnapshots, partition, sizeof(partition));
+            fprintf(stderr, "import: cannot update %s\n", partition);
+            failed += last - first;
+        } else {
+            *imported += added;
+            *duplicates += skipped;
+        }
+        first = last;
+    }
+    return failed;
+}
+
+
+
+
+
+
+
+
+// BENCHMARK
+
+// Returns the next value of a small xorshift generator, so datasets are the same on every
+// platform and run (rand() differs between C libraries)
+unsigned int benchmarkRandom(unsigned long long *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (unsigned int)((*state * 2685821657736338717ull) >> 32);
+}
+
+
+
+
+
+
+
+
+// Counts the Monday-to-Friday days of a partition month
+int weekdaysInMonth(int month) {
+    int firstDay = daysFromCivil(month / 12, month % 12 + 1, 1);
+    int nextFirstDay = daysFromCivil((month + 1) / 12, (month + 1) % 12 + 1, 1);
+    int weekdays = 0;
+    for (int day = firstDay; day < nextFirstDay; day++) {
+        int weekday = ((day + 4) % 7 + 7) % 7;     // 1970-01-01 was a Thursday; 0 is Sunday
+        if (weekday != 0 && weekday != 6) weekdays++;
+    }
+    return weekdays;
+}
+
+
+
+
+
+
+
+
+// Fills the employee store with count synthetic employees and builds their indexes, as
+// loadFromFile would; IDs are spread over the whole 7-digit range with no two adjacent
+// Returns 1 on success, 0 when out of memory
+int generateBenchmarkEmployees(int count) {
+    static const char *firstNames[] = { "Maria", "Jose", "Ana", "Juan", "Rosa", "Pedro", "Luz", "Carlos" };
+    static const char *lastNames[] = { "Santos", "Reyes", "Cruz", "Bautista", "Garcia", "Mendoza", "Torres", "Ramos" };
+    if (!storeReserve(&employeeStore, count)) return 0;
+
+    unsigned long long state = 0x9E3779B97F4A7C15ull;
+    int stride = EMPLOYEE_ID_SPACE / count;
+    for (int i = 0; i < count; i++) {
+        // A letters-only tag keeps every name unique and valid for the name prompts
+        char tag[8];
+        int len = 0;
+        for (int n = i; len == 0 || n > 0; n /= 26) tag[len++] = (char)('a' + n % 26);
+        tag[len] = '\0';
+        tag[0] = (char)toupper((unsigned char)tag[0]);
+
+        Employee e = {0};
+        e.empID = MIN_EMPLOYEE_ID + i * stride + (stride > 1 ? (int)(benchmarkRandom(&state) % (unsigned)(stride - 1)) : 0);
+        snprintf(e.name, sizeof(e.name), "%s %s %s", firstNames[benchmarkRandom(&state) % 8],
+                 lastNames[benchmarkRandom(&state) % 8], tag);
+        e.position = (PositionType)(benchmarkRandom(&state) % NUM_POSITIONS);
+        e.monthlySalary = PositionMonthlySalaries[e.position];
+        e.changeGeneration = 1;
+        *employeeAt(i) = e;
+    }
+    employeeCount = count;
+    rebuildEmployeeIDIndex();
+    rebuildEmployeeIDAllocator();
+    rebuildEmployeeIndexes();
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Fills store with one punch per employee for every weekday of a month, day by day in
+// employee order: mostly on time, some late, a few absent, some with overtime
+// Returns 1 on success, 0 when out of memory; *count receives the number of records
+int generateBenchmarkMonth(int month, ChunkedStore *store, int *count) {
+    *count = 0;
+    if (!storeReserve(store, weekdaysInMonth(month) * employeeCount)) return 0;
+
+    unsigned long long state = 0xD1B54A32D192ED03ull ^ (unsigned long long)month;
+    int firstDay = daysFromCivil(month / 12, month % 12 + 1, 1);
+    int nextFirstDay = daysFromCivil((month + 1) / 12, (month + 1) % 12 + 1, 1);
+    for (int day = firstDay; day < nextFirstDay; day++) {
+        int weekday = ((day + 4) % 7 + 7) % 7;
+        if (weekday == 0 || weekday == 6) continue;
+        for (int i = 0; i < employeeCount; i++) {
+            AttendanceRecord *r = storeAt(store, (*count)++);
+            unsigned int roll = benchmarkRandom(&state);
+            memset(r, 0, sizeof(*r));
+            r->empID = employeeAt(i)->empID;
+            r->day = day;
+            if (roll % 100 < 5) {
+                r->status = ATTENDANCE_ABSENT;
+                continue;
+            }
+            r->status = ATTENDANCE_PRESENT;
+            r->isLate = roll % 100 < 15;
+            r->timeIn = (unsigned short)(r->isLate ? 8 * 60 + 1 + (roll >> 8) % 59 : 7 * 60 + 30 + (roll >> 8) % 31);
+            r->hoursWorked = 800;
+            if ((roll >> 16) % 5 == 0) r->overtimeHours = (unsigned short)(50 * ((roll >> 20) % 4 + 1));
+        }
+    }
+    return 1;
+}
+
+
+
+
+
+
+
+
+// Deletes the data files a benchmark dataset of the given number of months may have written
+void removeBenchmarkFiles(int months) {
+    remove(FILENAME);
+    remove(BINARY_FILENAME);
+    remove(PAYROLL_JOURNAL_FILE);
+    remove(ATTENDANCE_JOURNAL_FILE);
+    int current = currentPartitionMonth();
+    for (int m = 0; m < months; m++) {
+        char path[MAX_STR];
+        partitionPath(current - m, 0, path, sizeof(path));
+        remove(path);
+        partitionPath(current - m, 1, path, sizeof(path));
+        remove(path);
+    }
+}
+
+
+
+
+
+
+
+
+// Drops every employee and their indexes from memory (nothing is saved)
+void clearEmployeeData(void) {
+    pendingSaves.count = 0;
+    freeEmployeeIDIndex();
+    freeEmployeeIDAllocator();
+    freeEmployeeIndexes();
+    storeFree(&employeeStore);
+    employeeCount = 0;
+    payrollGeneration = 0;
+    payrollJournalCount = 0;
+}
+
+
+
+
+
+
+
+
+// Drops the loaded attendance, its indexes and cached months from memory (nothing is saved)
+void clearAttendanceData(void) {
+    freeAttendanceDayIndex();
+    freeAttendanceOrderIndex();
+    freePartitionCache();
+    storeFree(&attendanceStore);
+    attendanceCount = 0;
+    attendanceJournalCount = 0;
+    attendanceGeneration = 0;
+    attendanceFoldedCount = -1;
+    foldedPeriodFirstDay = -1;
+    foldedPeriodLastDay = -1;
+}
+
+
+
+
+
+
+
+
+// Times saveToFile in the current file format
+double benchSaveEmployees(BenchmarkRun *run, long long *items) {
+    (void)run;
+    unsigned long long generation = payrollGeneration;
+    double start = wallClockMs();
+    saveToFile();
+    double elapsed = wallClockMs() - start;
+    *items = employeeCount;
+    return payrollGeneration != generation ? elapsed : -1.0;
+}
+
+
+
+
+
+
+
+
+// Times saving the active month's attendance in the current file format
+double benchSaveAttendance(BenchmarkRun *run, long long *items) {
+    (void)run;
+    double start = wallClockMs();
+    int ok = saveAttendanceToFile();
+    double elapsed = wallClockMs() - start;
+    *items = attendanceCount;
+    return ok ? elapsed : -1.0;
+}
 
-    printf("\n\t\t\t\t                          ========= MONTHLY SALARY SLIP =========\n");
-    printf("\t\t\t\t                          Employee ID:           %d\n", e.empID);
-    printf("\t\t\t\t                          Employee Name:         %s\n", e.name);
-    printf("\t\t\t\t                          Position:              %s\n", PositionNames[e.position]);
-    printf("\t\t\t\t                          Monthly Salary Base:   Php%.2f\n", e.monthlySalary);
-    printf("\t\t\t\t                          Daily Rate:            Php%.2f\n", e.lastDailyRate);
-    printf("\t\t\t\t                          Days Worked:           %d / %d\n", e.daysWorked, STANDARD_WORKING_DAYS);
-    printf("\t\t\t\t                          -----------------------------------------\n");
 
-    float totalDeduction = e.lastSSS + e.lastPhilHealth + e.lastPagIBIG + e.lastIncomeTax;
-    float actualBasicPay = e.lastDailyRate * e.daysWorked;
-    if (actualBasicPay < 0.0f) actualBasicPay = 0.0f;
 
-    printf("\t\t\t\t                          EARNINGS:\n"); 
-    printf("\t\t\t\t                          - Basic Salary (Days Worked):   Php%.2f\n", actualBasicPay);
-    // Overtime removed from slip
-    if (e.lastAbsentDeduct > 0.0f && e.daysWorked < STANDARD_WORKING_DAYS) {
-        printf("\t\t\t\t                          - Less: Absent Deduction:        Php%.2f\n", e.lastAbsentDeduct); 
-    }
-    printf("\t\t\t\t                          -----------------------------------------\n");
-    printf("\t\t\t\t                          TOTAL GROSS PAY:                 Php%.2f\n", e.lastGrossPay); 
-    printf("\t\t\t\t                          -----------------------------------------\n");
-    printf("\t\t\t\t                          DEDUCTIONS:\n");
-    printf("\t\t\t\t                          - SSS (4.5%%):              Php%.2f\n", e.lastSSS);
-    printf("\t\t\t\t                          - PhilHealth (2.5%%):       Php%.2f\n", e.lastPhilHealth);
-    printf("\t\t\t\t                          - Pag-IBIG (2%%):           Php%.2f\n", e.lastPagIBIG);
-    printf("\t\t\t\t                          - Income Tax:              Php%.2f\n", e.lastIncomeTax);
-    printf("\t\t\t\t                          -----------------------------------------\n");
-    printf("\t\t\t\t                          TOTAL DEDUCTIONS:          Php%.2f\n", totalDeduction);
-    printf("\t\t\t\t                          NET SALARY:                Php%.2f\n", e.lastNetPay);
-    printf("\t\t\t\t                          =========================================\n");
 
-    printf("\n\t\t\t\t               Do you want to print this salary slip to a text file? (Y/N): ");
-    char choice = 'N';
-    if (scanf(" %c", &choice) != 1) choice = 'N';
-    clearInputBuffer();
 
-    if (choice == 'Y' || choice == 'y') {
-        printPaySlipToFile(&e);
+
+
+
+// Times writing each earlier month's partition file (generating the months is not timed)
+double benchSaveHistory(BenchmarkRun *run, long long *items) {
+    ChunkedStore store = { NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+    double elapsed = 0.0;
+    *items = 0;
+    for (int m = 1; m < run->months; m++) {
+        int month = activePartitionMonth - m;
+        int count;
+        if (!generateBenchmarkMonth(month, &store, &count)) {
+            elapsed = -1.0;
+            break;
+        }
+        double start = wallClockMs();
+        int ok = writeAttendancePartition(month, &store, count, 1);
+        elapsed += wallClockMs() - start;
+        if (!ok) {
+            elapsed = -1.0;
+            break;
+        }
+        *items += count;
     }
+    storeFree(&store);
+    return elapsed;
 }
 
 
@@ -1187,29 +7625,75 @@ void displayEmployeeSalarySlip(int id) {
 
 
 
-// Employee Management
+// Times loadFromFile from an empty employee store
+double benchLoadEmployees(BenchmarkRun *run, long long *items) {
+    clearEmployeeData();
+    double start = wallClockMs();
+    loadFromFile();
+    double elapsed = wallClockMs() - start;
+    *items = employeeCount;
+    return employeeCount == run->employees ? elapsed : -1.0;
+}
 
-// Displays a list of all employees in the system
-void viewEmployees(void) {
-    system(CLEAR_COMMAND);
-    if (employeeCount == 0) {
-        printf("\n\t\t\t\t                                   There is no employees yet.\n");
-        return;
+
+
+
+
+
+
+
+// Times loadAttendanceFromFile from an empty attendance store
+double benchLoadAttendance(BenchmarkRun *run, long long *items) {
+    clearAttendanceData();
+    double start = wallClockMs();
+    loadAttendanceFromFile();
+    double elapsed = wallClockMs() - start;
+    *items = attendanceCount;
+    return attendanceCount == run->attendance ? elapsed : -1.0;
+}
+
+
+
+
+
+
+
+
+// Times reading each earlier month's partition, as the history and report screens do
+double benchLoadHistory(BenchmarkRun *run, long long *items) {
+    double elapsed = 0.0;
+    *items = 0;
+    for (int m = 1; m < run->months; m++) {
+        ChunkedStore store = { NULL, 0, 0, ATTENDANCE_CHUNK_SHIFT, sizeof(AttendanceRecord) };
+        int count;
+        unsigned long long generation;
+        double start = wallClockMs();
+        int loaded = loadAttendancePartition(activePartitionMonth - m, &store, &count, &generation);
+        elapsed += wallClockMs() - start;
+        storeFree(&store);
+        if (!loaded) return -1.0;
+        *items += count;
     }
+    return *items == run->history ? elapsed : -1.0;
+}
 
-    printf("\n\n\t\t\t                 %d EMPLOYEE RECORDS\n", employeeCount);
-    printf("\t\t\t               ========================================================================================\n");
-    printf("\t\t\t               | %-8s   %-30s   %-22s  %-14s   |\n", "ID", "Name", "Position", "Monthly Base");
-    printf("\t\t\t               ========================================================================================\n");
 
-    for (int i = 0; i < employeeCount; i++) {
-        printf("\n\t\t\t                 %-8d   %-30s   %-22s   Php%-11.2f  \n",
-                employees[i].empID,
-                employees[i].name,
-                PositionNames[employees[i].position],
-                employees[i].monthlySalary);
+
+
+
+
+
+
+// Times findEmployeeIndexByID over the run's lookup IDs (half of them are not employees)
+double benchFindEmployee(BenchmarkRun *run, long long *items) {
+    int found = 0;
+    double start = wallClockMs();
+    for (int i = 0; i < BENCHMARK_LOOKUPS; i++) {
+        if (findEmployeeIndexByID(run->lookupIDs[i]) != -1) found++;
     }
-    printf("\n\n\t\t\t               ----------------------------------------------------------------------------------------\n");
+    double elapsed = wallClockMs() - start;
+    *items = BENCHMARK_LOOKUPS;
+    return found == BENCHMARK_LOOKUPS / 2 ? elapsed : -1.0;
 }
 
 
@@ -1219,44 +7703,98 @@ void viewEmployees(void) {
 
 
 
+// Times the aggregation behind viewAttendance; items are the records in the pay period
+double benchAggregateAttendance(BenchmarkRun *run, long long *items) {
+    (void)run;
+    AttendanceSummary *summaries = malloc((size_t)employeeCount * sizeof(AttendanceSummary));
+    if (!summaries) return -1.0;
+    double start = wallClockMs();
+    int ok = aggregateAttendance(summaries);
+    double elapsed = wallClockMs() - start;
+    free(summaries);
+
+    int firstDay, lastDay;
+    currentPayPeriod(&firstDay, &lastDay);
+    *items = orderIndexLowerBound(lastDay + 1) - orderIndexLowerBound(firstDay);
+    return ok ? elapsed : -1.0;
+}
 
 
 
 
 
 
-// Sort employees in-place by Employee ID using Insertion Sort (stable, efficient for small N)
-void sortEmployeesByID(void) {
-    if (employeeCount <= 1) return;
-    for (int i = 1; i < employeeCount; i++) {
-        Employee key = employees[i];
-        int j = i - 1;
-        while (j >= 0 && employees[j].empID > key.empID) {
-            employees[j + 1] = employees[j];
-            j--;
-        }
-        employees[j + 1] = key;
+
+
+// Times the payroll run behind calculateAndDisplaySalary with every employee out of date
+double benchComputePayroll(BenchmarkRun *run, long long *items) {
+    (void)run;
+    for (int i = 0; i < employeeCount; i++) {
+        markPayrollInputChanged(i);
     }
-    saveToFile();
-    printf("\nEmployees sorted by ID successfully and saved to file.\n");
+    double start = wallClockMs();
+    int recomputed = recomputeStalePayroll();
+    double elapsed = wallClockMs() - start;
+    *items = recomputed;
+    return recomputed == employeeCount ? elapsed : -1.0;
+}
+
+
+
+
+
+
+
+
+// Times rendering every employee's payslip into memory
+double benchRenderPayslips(BenchmarkRun *run, long long *items) {
+    (void)run;
+    char slip[PAYSLIP_BUFFER_SIZE];
+    size_t bytes = 0;
+    double start = wallClockMs();
+    for (int i = 0; i < employeeCount; i++) {
+        bytes += renderPaySlip(employeeAt(i), slip, sizeof(slip));
+    }
+    double elapsed = wallClockMs() - start;
+    *items = employeeCount;
+    return bytes > 0 ? elapsed : -1.0;
 }
 
-// Sort employees in-place by Name using Insertion Sort (ascending A-Z)
-void sortEmployeesByName(void) {
-    if (employeeCount <= 1) return;
-    for (int i = 1; i < employeeCount; i++) {
-        Employee key = employees[i];
-        int j = i - 1;
 
-        // Use case-insensitive comparison for alphabetical ordering
-        while (j >= 0 && strcasecmp(employees[j].name, key.name) > 0) {
-            employees[j + 1] = employees[j];
-            j--;
+
+
+
+
+
+
+// Runs a step BENCHMARK_REPEATS times, then prints its timings and appends them as one JSON
+// line (format is "text" or "binary" for the file steps, NULL for the in-memory ones)
+// Returns 1 on success, 0 if the step failed
+int runBenchmarkCase(BenchmarkRun *run, const char *name, const char *format, BenchmarkStep step) {
+    double best = 0.0, total = 0.0;
+    long long items = 0;
+    for (int r = 0; r < BENCHMARK_REPEATS; r++) {
+        double elapsed = step(run, &items);
+        if (elapsed < 0) {
+            fprintf(stderr, "benchmark: %s%s%s failed with %d employees\n", name, format ? " " : "",
+                    format ? format : "", run->employees);
+            return 0;
         }
-        employees[j + 1] = key;
+        if (r == 0 || elapsed < best) best = elapsed;
+        total += elapsed;
     }
-    saveToFile();
-    printf("\nEmployees sorted by Name successfully and saved to file.\n");
+    double mean = total / BENCHMARK_REPEATS;
+    double nsPerItem = items > 0 ? best * 1000000.0 / (double)items : 0.0;
+
+    fprintf(run->out, "{\"run\":\"%s\",\"case\":\"%s\",", run->started, name);
+    if (format) fprintf(run->out, "\"format\":\"%s\",", format);
+    fprintf(run->out, "\"employees\":%d,\"attendance\":%d,\"history\":%lld,\"items\":%lld,\"repeats\":%d,"
+            "\"best_ms\":%.3f,\"mean_ms\":%.3f,\"ns_per_item\":%.1f}\n",
+            run->employees, run->attendance, run->history, items, BENCHMARK_REPEATS, best, mean, nsPerItem);
+    fflush(run->out);
+    printf("  %-20s %-6s %10lld items   best %10.3f ms   mean %10.3f ms   %10.1f ns/item\n",
+           name, format ? format : "", items, best, mean, nsPerItem);
+    return 1;
 }
 
 
@@ -1266,81 +7804,118 @@ void sortEmployeesByName(void) {
 
 
 
-// Adds a new employee to the system
-void addEmployee(void) {
-    system(CLEAR_COMMAND);
-    if (employeeCount >= MAX_EMPLOYEES) {
-        printf("\n\t\t\t\t\tEmployee list is full (max %d). Cannot add more employees.\n", MAX_EMPLOYEES);
-        return;
+// Generates one dataset of run->employees employees and measures every step on it, first
+// with text files and then with binary snapshots; its files are deleted afterwards
+// Returns 1 if every step ran, 0 if one failed or memory ran out
+int benchmarkDataset(BenchmarkRun *run) {
+    static const char *formats[] = { "text", "binary" };
+    removeBenchmarkFiles(run->months);
+    clearEmployeeData();
+    clearAttendanceData();
+    printf("\nGenerating %d employees with %d month(s) of attendance...\n", run->employees, run->months);
+
+    activePartitionMonth = currentPartitionMonth();
+    if (!generateBenchmarkEmployees(run->employees) ||
+        !generateBenchmarkMonth(activePartitionMonth, &attendanceStore, &attendanceCount)) {
+        fprintf(stderr, "benchmark: out of memory generating %d employees\n", run->employees);
+        return 0;
+    }
+    rebuildAttendanceDayIndex();
+    rebuildAttendanceOrderIndex();
+    run->attendance = attendanceCount;
+    run->history = 0;
+    for (int m = 1; m < run->months; m++) {
+        run->history += (long long)run->employees * weekdaysInMonth(activePartitionMonth - m);
     }
 
-    Employee e;
-    printf("\n\t\t\t\t                                        ADD NEW EMPLOYEE\n");
-    
-    // Generate random 7-digit ID
-    e.empID = generateEmployeeID();
-    printf("\t\t\t                                         Generated Employee ID: %d\n", e.empID);
-    
-    // Get name with duplicate validation
-    char name[50];
-    while (1) {
-        getStringInput("\n\t\t\t\t                             Enter Full Name: ", name, sizeof(name), 1);
-        
-        if (findEmployeeIndexByName(name) != -1) {
-            printf("\t\t\t\t                    Employee with name '%s' already exists!\n", name);
-            printf("\t\t\t\t                                   Please enter a different person.\n");
-            continue;
-        }
-        break;
+    // Every other lookup is one past an employee's ID, which the ID spacing leaves unused
+    unsigned long long state = 0xA0761D6478BD642Full;
+    for (int i = 0; i < BENCHMARK_LOOKUPS; i++) {
+        int id = employeeAt((int)(benchmarkRandom(&state) % (unsigned)run->employees))->empID;
+        run->lookupIDs[i] = (i & 1) ? id + 1 : id;
     }
-    strcpy(e.name, name);
 
-    printf("\n\t\t\t\t                                         SELECT POSITION\n");
-    for (int i = 0; i < NUM_POSITIONS; i++) {
-        printf("\t\t\t\t                           %d. %s       Php%.2f per month\n",   i + 1, PositionNames[i],       PositionMonthlySalaries[i]);
+    int ok = 1;
+    for (int f = 0; f < 2 && ok; f++) {
+        useBinarySnapshots = f;
+        ok = runBenchmarkCase(run, "save_employees", formats[f], benchSaveEmployees)
+          && runBenchmarkCase(run, "save_attendance", formats[f], benchSaveAttendance)
+          && (run->months < 2 || runBenchmarkCase(run, "save_history", formats[f], benchSaveHistory))
+          && runBenchmarkCase(run, "load_employees", formats[f], benchLoadEmployees)
+          && runBenchmarkCase(run, "load_attendance", formats[f], benchLoadAttendance)
+          && (run->months < 2 || runBenchmarkCase(run, "load_history", formats[f], benchLoadHistory));
     }
-    int posChoice = getIntInput("\n\n\t\t\t\t                                          Choice: ", 1, NUM_POSITIONS);
+    ok = ok && runBenchmarkCase(run, "find_employee", NULL, benchFindEmployee)
+            && runBenchmarkCase(run, "aggregate_attendance", NULL, benchAggregateAttendance)
+            && runBenchmarkCase(run, "compute_payroll", NULL, benchComputePayroll)
+            && runBenchmarkCase(run, "render_payslips", NULL, benchRenderPayslips);
+    removeBenchmarkFiles(run->months);
+    return ok;
+}
 
 
 
 
 
-    e.position = (PositionType)(posChoice - 1);
-    e.monthlySalary = PositionMonthlySalaries[e.position];
-    
-    e.daysWorked = 0;
 
-    // Initialize all calculation fields
-    e.totalOvertimeHours = 0.0f;
-    e.totalHoursWorked = 0.0f;
-    e.lastOvertimePay = 0.0f;
-    e.lastDailyRate = 0.0f;
-    e.lastAbsentDeduct = 0.0f;
-    e.lastGrossPay = 0.0f;
-    e.lastNetPay = 0.0f;
-    e.lastSSS = 0.0f;
-    e.lastPhilHealth = 0.0f;
-    e.lastPagIBIG = 0.0f;
-    e.lastIncomeTax = 0.0f;
 
-    printf("\n\t\t\t\t                                         EMPLOYEE DETAIL\n");
-    printf("\n\t\t\t\t                                  ID:                %d\n", e.empID);
-    printf("\t\t\t\t                                  Name:              %s\n", e.name);
-    printf("\t\t\t\t                                  Position:          %s\n", PositionNames[e.position]);
-    printf("\t\t\t\t                                  Monthly Salary:    Php%.2f\n", e.monthlySalary);
-    
-    printf("\n\t\t\t\t\tConfirm Add? (Y to confirm, any other key to cancel): ");
-    char c = 'N';
-    if (scanf(" %c", &c) != 1) c = 'N';
-    clearInputBuffer();
 
-    if (c == 'Y' || c == 'y') {
-        employees[employeeCount++] = e;
-        saveToFile();
-        printf("\n\t\t\t\t                    Employee '%s' added successfully with ID: %d.\n", e.name, e.empID);
-    } else {
-        printf("\n\t\t\t\t                                Adding cancelled. No changes made.\n");
+// Runs the benchmark: `benchmark [max employees] [months]` measures datasets of 1000, 10000, ...
+// employees up to the maximum, working in BENCHMARK_DATA_DIR so the real data files are never
+// touched; returns the process exit code (0 ok, 1 failed, 2 usage)
+int runBenchmark(int argc, char *argv[]) {
+    int maxEmployees = argc >= 3 ? atoi(argv[2]) : BENCHMARK_DEFAULT_EMPLOYEES;
+    int months = argc >= 4 ? atoi(argv[3]) : 1;
+    if (argc > 4 || maxEmployees < 1 || maxEmployees > BENCHMARK_MAX_EMPLOYEES || months < 1 ||
+        months > BENCHMARK_MAX_MONTHS) {
+        fprintf(stderr, "benchmark: expected [employees (1-%d)] [months (1-%d)]\n", BENCHMARK_MAX_EMPLOYEES,
+                BENCHMARK_MAX_MONTHS);
+        return 2;
+    }
+    long long records = 0;
+    for (int m = 0; m < months; m++) {
+        records += (long long)maxEmployees * weekdaysInMonth(currentPartitionMonth() - m);
+    }
+    if (records > BENCHMARK_MAX_ATTENDANCE) {
+        fprintf(stderr, "benchmark: %d employees over %d months make %lld attendance records (at most %lld)\n",
+                maxEmployees, months, records, BENCHMARK_MAX_ATTENDANCE);
+        return 2;
     }
+
+    FILE *out = fopen(BENCHMARK_OUTPUT_FILE, "a");
+    if (!out) {
+        fprintf(stderr, "benchmark: cannot open %s\n", BENCHMARK_OUTPUT_FILE);
+        return 1;
+    }
+    MAKE_DIRECTORY(BENCHMARK_DATA_DIR);     // fails harmlessly when it already exists
+    BenchmarkRun run = {0};
+    run.out = out;
+    run.months = months;
+    run.lookupIDs = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    if (!run.lookupIDs || CHANGE_DIRECTORY(BENCHMARK_DATA_DIR) != 0) {
+        fprintf(stderr, "benchmark: cannot work in %s\n", BENCHMARK_DATA_DIR);
+        free(run.lookupIDs);
+        fclose(out);
+        return 1;
+    }
+    time_t now = time(NULL);
+    strftime(run.started, sizeof(run.started), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    printf("Benchmark %s: results are appended to %s, data is written in %s/\n", run.started,
+           BENCHMARK_OUTPUT_FILE, BENCHMARK_DATA_DIR);
+
+    int status = 0;
+    for (int size = 1000; status == 0; size *= 10) {
+        run.employees = size < maxEmployees ? size : maxEmployees;
+        if (!benchmarkDataset(&run)) status = 1;
+        if (run.employees == maxEmployees) break;
+    }
+
+    clearEmployeeData();
+    clearAttendanceData();
+    free(pendingSaves.changes);
+    free(run.lookupIDs);
+    if (fclose(out) != 0) status = 1;
+    return status;
 }
 
 
@@ -1350,107 +7925,273 @@ void addEmployee(void) {
 
 
 
-// Updates an existing employee's information
-void updateEmployee(void) {
-    system(CLEAR_COMMAND);
-    if (employeeCount == 0) {
-        printf("\n\t\t\t\t                                There is no employees yet to update.\n");
-        return;
-    }
-    printf("\n\t\t\t\t                                        UPDATE EMPLOYEE\n");
-    
-    int id;
-    printf("\n\t\t\t\t                             Enter Employee ID to update: ");
-    if (scanf("%d", &id) != 1) {
-        printf("\t\t\t\t                             Invalid ID format.\n");
-        clearInputBuffer();
-        return;
+// BATCH MODE (command-line subcommands: no screen clears, prompts or animations)
+
+// Prints the list of batch subcommands
+void printUsage(const char *program) {
+    printf("Usage: %s [command] [arguments]\n", program);
+    printf("Without a command the interactive menu is started.\n");
+    printf("--quiet (or -q) before the command, %s=1, or quiet=1 in %s skips animations and screen clears.\n\n",
+           QUIET_ENV_VAR, SETTINGS_FILE);
+    printf("Commands:\n");
+    printf("  compute-payroll [out.csv]     compute monthly pay for every employee and save it\n");
+    printf("  import-attendance <file>      add punches (\"empID YYYY-MM-DD HH:MM hours status isLate overtime\")\n");
+    printf("  import-employees-csv <file>   add employees from CSV (empID,name,position; blank empID = next free ID)\n");
+    printf("  export-employees-csv [file]   write every employee as CSV\n");
+    printf("  import-attendance-csv <file>  add attendance from CSV (empID,date,timeIn,hoursWorked,status,isLate,overtimeHours)\n");
+    printf("  export-attendance-csv <file|-> [YYYY-MM]\n");
+    printf("                                write a month's attendance as CSV (default: this month)\n");
+    printf("  attendance-report [YYYY-MM]   print attendance totals for a month (default: this month)\n");
+    printf("  export-payslips [dir]         write payslip_<id>.txt for every computed employee\n");
+    printf("  export-payslip-archive [file] write every computed payslip into one indexed file\n");
+    printf("  serve [port]                  accept kiosk punches on 127.0.0.1 (default port %d)\n", KIOSK_DEFAULT_PORT);
+    printf("  export-binary                 save the data as binary snapshots\n");
+    printf("  export-text                   save the data as text files\n");
+    printf("  benchmark [employees] [months]\n");
+    printf("                                time loading, saving, lookups, attendance and payroll on generated\n");
+    printf("                                data in %s/ (default %d employees, 1 month); results are\n",
+           BENCHMARK_DATA_DIR, BENCHMARK_DEFAULT_EMPLOYEES);
+    printf("                                appended to %s as JSON lines\n", BENCHMARK_OUTPUT_FILE);
+    printf("  help                          show this message\n");
+}
+
+
+
+
+
+
+
+
+// Computes and saves payroll for every employee
+int batchComputePayroll(void) {
+    if (recomputeStalePayroll() < 0) {
+        fprintf(stderr, "compute-payroll: out of memory\n");
+        return 1;
     }
-    clearInputBuffer();
-    
-    if (id < 1000000 || id > 9999999) {
-        printf("\t\t\t\t                                Invalid Employee ID. Must be 7 digits.\n");
-        return;
+    flushPendingSaves(1);
+    return 0;
+}
+
+
+
+
+
+
+
+
+// Adds the punches in a journal-format file, skipping unknown employees and duplicate days
+// Punches for the active month go through the attendance store; other months are merged
+// straight into their partition files
+int batchImportAttendance(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "import-attendance: cannot open %s\n", path);
+        return 1;
     }
-    
-    int idx = findEmployeeIndexByID(id);
 
-    if (idx == -1) {
-        printf("\n\t\t\t\t                                Employee with ID %d not found.\n", id);
-        return;
+    AttendanceRecord *other = NULL;
+    int otherCount = 0, otherCapacity = 0;
+    int imported = 0, duplicates = 0, rejected = 0, lineNo = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        lineNo++;
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == 0 || line[0] == '#' || strncmp(line, "GEN ", 4) == 0) continue;
+
+        AttendanceRecord r;
+        if (!parseAttendanceLine(line, &r)) {
+            fprintf(stderr, "%s:%d: unreadable record\n", path, lineNo);
+            rejected++;
+            continue;
+        }
+        if (findEmployeeIndexByID(r.empID) == -1) {
+            fprintf(stderr, "%s:%d: unknown employee %d\n", path, lineNo, r.empID);
+            rejected++;
+            continue;
+        }
+        if (monthOfDay(r.day) != activePartitionMonth) {
+            if (otherCount == otherCapacity) {
+                int capacity = otherCapacity ? otherCapacity * 2 : 256;
+                AttendanceRecord *grown = realloc(other, (size_t)capacity * sizeof(AttendanceRecord));
+                if (!grown) {
+                    fprintf(stderr, "import-attendance: out of memory at %s:%d\n", path, lineNo);
+                    free(other);
+                    fclose(fp);
+                    return 1;
+                }
+                other = grown;
+                otherCapacity = capacity;
+            }
+            other[otherCount++] = r;
+            continue;
+        }
+        if (dayIndexGet(r.empID, r.day) != -1) {
+            duplicates++;
+            continue;
+        }
+        if (appendAttendanceRecord(&r) < 0) {
+            fprintf(stderr, "import-attendance: out of memory at %s:%d\n", path, lineNo);
+            free(other);
+            fclose(fp);
+            return 1;
+        }
+        imported++;
     }
+    fclose(fp);
 
-    Employee *e = &employees[idx];
-    Employee old = *e;
+    if (imported > 0) saveAttendanceToFile();
 
-    printf("\n\t\t\t\t                                  Current Employee Details\n");
-    printf("\t\t\t\t                                  Name:        %s\n", e->name);
-    printf("\t\t\t\t                                  Position:    %s (Php%.2f/month)\n", PositionNames[e->position], e->monthlySalary);
-    printf("\t\t\t\t                                  Days Worked: %d\n", e->daysWorked);
+    rejected += mergeImportedAttendance(other, otherCount, &imported, &duplicates);
+    free(other);
+    printf("Imported %d records (%d duplicates skipped, %d rejected).\n", imported, duplicates, rejected);
+    return rejected > 0 ? 1 : 0;
+}
 
-    printf("\n\t\t\t\t                                Which field do you want to update?\n");
-    printf("\t\t\t\t                                1) Name\n");
-    printf("\t\t\t\t                                2) Position and Monthly Salary\n");
-    printf("\t\t\t\t                                3) Back\n");
-    int choice = getIntInput("\t\t\t\t                                          Choice: ", 1, 3);
 
-    if (choice == 3) {
-        printf("\n\t\t\t\t                              Update cancelled.\n");
-        return;
+
+
+
+
+
+
+// Adds the employees listed in a CSV file (empID,name,position; further columns are ignored)
+// Names follow the same rules as typed names; a blank empID is given the next free ID.
+// A row that fails a check is reported with its line number and skipped.
+int batchImportEmployeesCsv(const char *path) {
+    CsvReader csv;
+    if (!csvOpen(&csv, path)) {
+        fprintf(stderr, "import-employees-csv: cannot open %s\n", path);
+        return 1;
     }
 
-    switch (choice) {
-        case 1: {
-            char newName[50];
-            while (1) {
-                getStringInput("\n\t\t\t\t                             Enter new full name: ", newName, sizeof(newName), 1);
-                
-                if (isNameDuplicate(newName, e->empID)) {
-                    printf("\t\t\t\t                    The Employee with name '%s' already exists!\n", newName);
-                    printf("\t\t\t\t                    Sorry you can't add the same person.\n");
-                    continue;
-                }
-                break;
+    // IDs for rows without one are reserved IMPORT_ID_BLOCK at a time
+    int ids[IMPORT_ID_BLOCK];
+    int idsNext = 0, idsCount = 0;
+    int imported = 0, rejected = 0, failed = 0;
+    char *fields[CSV_MAX_FIELDS];
+    int n;
+    while ((n = csvReadRow(&csv, fields, CSV_MAX_FIELDS)) != -1) {
+        if (n == CSV_ROW_TOO_LONG) {
+            fprintf(stderr, "%s:%d: row longer than %d bytes\n", path, csv.lineNo, CSV_CHUNK_SIZE);
+            rejected++;
+            continue;
+        }
+        if (n == 1 && fields[0][0] == '\0') continue;
+        for (int f = 0; f < n && f < CSV_MAX_FIELDS; f++) trimInput(fields[f]);
+        if (csv.lineNo == 1 && strcmp(fields[0], "empID") == 0) continue;
+        if (n < 3) {
+            fprintf(stderr, "%s:%d: expected empID,name,position\n", path, csv.lineNo);
+            rejected++;
+            continue;
+        }
+
+        const char *problem = validateTextInput(fields[1], 1);
+        if (problem) {
+            fprintf(stderr, "%s:%d: %s\n", path, csv.lineNo, problem);
+            rejected++;
+            continue;
+        }
+        if (isNameDuplicate(fields[1], 0)) {
+            fprintf(stderr, "%s:%d: an employee named '%s' already exists\n", path, csv.lineNo, fields[1]);
+            rejected++;
+            continue;
+        }
+        int position = -1;
+        for (int p = 0; p < NUM_POSITIONS; p++) {
+            if (strcasecmp(fields[2], PositionNames[p]) == 0) position = p;
+        }
+        if (position == -1) {
+            fprintf(stderr, "%s:%d: unknown position '%s'\n", path, csv.lineNo, fields[2]);
+            rejected++;
+            continue;
+        }
+
+        int id;
+        if (fields[0][0] == '\0') {
+            if (idsNext == idsCount) {
+                idsCount = allocateEmployeeIDs(IMPORT_ID_BLOCK, ids);
+                idsNext = 0;
             }
-            if (strcmp(e->name, newName) == 0) {
-                printf("\t\t\t\t                         New name is the same as current name. Update cancelled.\n");
-                return;
+            if (idsNext == idsCount) {
+                fprintf(stderr, "%s:%d: every employee ID is already taken\n", path, csv.lineNo);
+                rejected++;
+                continue;
             }
-            strcpy(e->name, newName);
-            printf("\t\t\t\t                                 Name updated to: %s\n", e->name);
-            break;
-        }
-        case 2: {
-            printf("\n\t\t\t\t                                  SELECT NEW POSITION\n");
-            for (int i = 0; i < NUM_POSITIONS; i++) {
-                printf("\t\t\t\t                                  %d. %s (Php%.2f per month)\n",
-                        i + 1, PositionNames[i], PositionMonthlySalaries[i]);
+            id = ids[idsNext++];
+        } else {
+            double value;
+            if (!parseCsvNumber(fields[0], MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID, &value) || value != (int)value) {
+                fprintf(stderr, "%s:%d: employee ID must be 7 digits (%d-%d)\n", path, csv.lineNo,
+                        MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID);
+                rejected++;
+                continue;
             }
-            int posChoice = getIntInput("\t\t\t\t                                          Choice: ", 1, NUM_POSITIONS);
-            PositionType newPosition = (PositionType)(posChoice - 1);
-            if (e->position == newPosition) {
-                printf("\t\t\t\t                         New position is the same as current position. Update cancelled.\n");
-                return;
+            id = (int)value;
+            if (findEmployeeIndexByID(id) != -1) {
+                fprintf(stderr, "%s:%d: employee ID %d already exists\n", path, csv.lineNo, id);
+                rejected++;
+                continue;
             }
-            e->position = newPosition;
-            e->monthlySalary = PositionMonthlySalaries[e->position];
-            printf("\n\t\t\t\t                    Position updated to %s (Php%.2f/month).\n", PositionNames[e->position], e->monthlySalary);
+            // An ID already reserved for a later row without one is taken out of the block
+            for (int k = idsNext; k < idsCount; k++) {
+                if (ids[k] == id) {
+                    memmove(ids + k, ids + k + 1, (size_t)(idsCount - k - 1) * sizeof(int));
+                    idsCount--;
+                    break;
+                }
+            }
+            markEmployeeIDUsed(id);
+        }
+
+        Employee e = {0};
+        e.empID = id;
+        snprintf(e.name, sizeof(e.name), "%s", fields[1]);
+        e.position = (PositionType)position;
+        e.monthlySalary = PositionMonthlySalaries[e.position];
+        e.changeGeneration = 1;
+        if (storeNewEmployee(&e) < 0) {
+            fprintf(stderr, "import-employees-csv: out of memory at %s:%d\n", path, csv.lineNo);
+            releaseEmployeeID(id);
+            failed = 1;
             break;
         }
+        imported++;
     }
+    csvClose(&csv);
 
-    printf("\t\t\t\t                    Confirm update? (Y to confirm, any other key to cancel): ");
-    char c = 'N';
-    if (scanf(" %c", &c) != 1) c = 'N';
-    clearInputBuffer();
+    // Unused reserved IDs go back in reverse so the cursor returns to the first of them
+    while (idsCount > idsNext) returnEmployeeID(ids[--idsCount]);
+    flushPendingSaves(1);
+    printf("Imported %d employees (%d rejected).\n", imported, rejected);
+    return failed || rejected > 0 ? 1 : 0;
+}
 
-    if (c == 'Y' || c == 'y') {
-        saveToFile();
-        printf("\n\t\t\t\t                             Employee updated and saved successfully.\n");
-    } else {
-        *e = old;
-        printf("\n\t\t\t\t                            Update cancelled; original record restored.\n");
+
+
+
+
+
+
+
+// Writes every employee as CSV (empID,name,position,monthlySalary) in ID order, to path or
+// to standard output when path is NULL or "-"
+int batchExportEmployeesCsv(const char *path) {
+    int toStdout = !path || strcmp(path, "-") == 0;
+    FILE *out = toStdout ? stdout : fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "export-employees-csv: cannot create %s\n", path);
+        return 1;
+    }
+    fprintf(out, "empID,name,position,monthlySalary\n");
+    const EmployeeSortIndex *index = &employeeSortIndexes[EMPLOYEE_ORDER_ID];
+    for (int i = 0; i < index->count; i++) {
+        const Employee *e = employeeAt(index->slots[i]);
+        fprintf(out, "%d,", e->empID);
+        writeCsvField(out, e->name);
+        fprintf(out, ",%s,%.2f\n", PositionNames[e->position], PESOS(e->monthlySalary));
     }
+    if (toStdout) return fflush(out) == 0 ? 0 : 1;
+    return fclose(out) == 0 ? 0 : 1;
 }
 
 
@@ -1460,92 +8201,126 @@ void updateEmployee(void) {
 
 
 
-// Removes an employee from the system
-void removeEmployee(void) {
-    system(CLEAR_COMMAND);
-    if (employeeCount == 0) {
-        printf("\n\t\t\t\t                                There is no employees yet to remove.\n");
-        pressEnterToContinue();
-        return;
+// Adds the attendance records listed in a CSV file
+// (empID,date,timeIn,hoursWorked,status,isLate,overtimeHours; date as YYYY-MM-DD, time as HH:MM)
+// Records for other months are merged into their partition files CSV_IMPORT_BATCH at a time,
+// so a file of any size is imported in bounded memory. A row that fails a check is reported
+// with its line number and skipped.
+int batchImportAttendanceCsv(const char *path) {
+    CsvReader csv;
+    if (!csvOpen(&csv, path)) {
+        fprintf(stderr, "import-attendance-csv: cannot open %s\n", path);
+        return 1;
     }
-    
-    printf("\n\t\t\t\t                                        REMOVE EMPLOYEE\n");
-    
-    int id;
-    while (1) {
-        printf("\n\t\t\t\t                        Enter Employee ID to remove (or 0 to cancel): ");
-        if (scanf("%d", &id) != 1) {
-            printf("\t\t\t\t                                Invalid ID format. Please enter numbers only.\n");
-            clearInputBuffer();
+    AttendanceRecord *other = malloc(CSV_IMPORT_BATCH * sizeof(AttendanceRecord));
+    if (!other) {
+        fprintf(stderr, "import-attendance-csv: out of memory\n");
+        csvClose(&csv);
+        return 1;
+    }
+
+    int otherCount = 0, imported = 0, importedActive = 0, duplicates = 0, rejected = 0, failed = 0;
+    char *fields[CSV_MAX_FIELDS];
+    int n;
+    while ((n = csvReadRow(&csv, fields, CSV_MAX_FIELDS)) != -1) {
+        if (n == CSV_ROW_TOO_LONG) {
+            fprintf(stderr, "%s:%d: row longer than %d bytes\n", path, csv.lineNo, CSV_CHUNK_SIZE);
+            rejected++;
             continue;
         }
-        clearInputBuffer();
-        
-        if (id == 0) {
-            printf("\n\t\t\t\t                                Remove operation cancelled.\n");
-            return;
+        if (n == 1 && fields[0][0] == '\0') continue;
+        for (int f = 0; f < n && f < CSV_MAX_FIELDS; f++) trimInput(fields[f]);
+        if (csv.lineNo == 1 && strcmp(fields[0], "empID") == 0) continue;
+        if (n < 7) {
+            fprintf(stderr, "%s:%d: expected empID,date,timeIn,hoursWorked,status,isLate,overtimeHours\n",
+                    path, csv.lineNo);
+            rejected++;
+            continue;
         }
-        
-        if (id < 1000000 || id > 9999999) {
-            printf("\t\t\t\t                                Invalid Employee ID. Must be 7 digits.\n");
+
+        double id, hours, late, overtime;
+        if (!parseCsvNumber(fields[0], MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID, &id) || id != (int)id) {
+            fprintf(stderr, "%s:%d: employee ID must be 7 digits (%d-%d)\n", path, csv.lineNo,
+                    MIN_EMPLOYEE_ID, MAX_EMPLOYEE_ID);
+            rejected++;
             continue;
         }
-        
-        int idx = findEmployeeIndexByID(id);
-        if (idx == -1) {
-            printf("\t\t\t\t                   Employee with ID %d not found. Please enter a valid ID.\n", id);
+        if (findEmployeeIndexByID((int)id) == -1) {
+            fprintf(stderr, "%s:%d: unknown employee %d\n", path, csv.lineNo, (int)id);
+            rejected++;
             continue;
         }
-        break;
-    }
-    
-    int idx = findEmployeeIndexByID(id);
-    printf("\n\t\t\t\t                                   EMPLOYEE TO BE REMOVED\n");
-    printf("\t\t\t\t                                  ID:              %d\n", employees[idx].empID);
-    printf("\t\t\t\t                                  Name:            %s\n", employees[idx].name);
-    printf("\t\t\t\t                                  Position:        %s\n", PositionNames[employees[idx].position]);
-    printf("\t\t\t\t                                  Monthly Salary:  Php%.2f\n", employees[idx].monthlySalary);
-    
-    printf("\n\t\t\t\t                       ARE YOU SURE YOU WANT TO REMOVE THIS EMPLOYEE?\n");
-    printf("\t\t\t\t    This action cannot be undone! (Type 'REMOVE' to confirm, any other key to cancel): ");
-    
-    char confirmation[10];
-    if (!fgets(confirmation, sizeof(confirmation), stdin)) {
-        printf("\n\t\t\t\t\tRemoval cancelled. No changes made.\n");
-        pressEnterToContinue();
-        return;
-    }
-    
-    confirmation[strcspn(confirmation, "\n")] = 0;
-    
-    if (strcmp(confirmation, "REMOVE") == 0) {
-        char deletedName[50];
-        strcpy(deletedName, employees[idx].name);
-        int deletedID = employees[idx].empID;
-        
-        // Remove employee from array
-        employees[idx] = employees[employeeCount - 1];
-        --employeeCount;
-        
-        // Remove attendance records for this employee
-        int newAttendanceCount = 0;
-        for (int i = 0; i < attendanceCount; i++) {
-            if (attendanceRecords[i].empID != deletedID) {
-                attendanceRecords[newAttendanceCount] = attendanceRecords[i];
-                newAttendanceCount++;
+        char date[11] = "";
+        int day = strlen(fields[1]) == 10 ? dateToDayNumber(fields[1]) : -1;
+        if (day >= 0) formatDayNumber(day, date);
+        if (day < 0 || strcmp(date, fields[1]) != 0) {
+            fprintf(stderr, "%s:%d: invalid date '%s' (expected YYYY-MM-DD)\n", path, csv.lineNo, fields[1]);
+            rejected++;
+            continue;
+        }
+        int timeIn = strlen(fields[2]) == 5 ? parseTimeOfDay(fields[2]) : -1;
+        if (timeIn < 0) {
+            fprintf(stderr, "%s:%d: invalid time '%s' (expected HH:MM)\n", path, csv.lineNo, fields[2]);
+            rejected++;
+            continue;
+        }
+        int status = -1;
+        for (int s = 0; s < NUM_ATTENDANCE_STATUSES; s++) {
+            if (strcasecmp(fields[4], AttendanceStatusNames[s]) == 0) status = s;
+        }
+        if (status == -1) {
+            fprintf(stderr, "%s:%d: unknown status '%s'\n", path, csv.lineNo, fields[4]);
+            rejected++;
+            continue;
+        }
+        if (!parseCsvNumber(fields[3], 0.0, 24.0, &hours) || !parseCsvNumber(fields[6], 0.0, 24.0, &overtime)) {
+            fprintf(stderr, "%s:%d: hours must be numbers from 0 to 24\n", path, csv.lineNo);
+            rejected++;
+            continue;
+        }
+        if (!parseCsvNumber(fields[5], 0.0, 1.0, &late) || late != (int)late) {
+            fprintf(stderr, "%s:%d: isLate must be 0 or 1\n", path, csv.lineNo);
+            rejected++;
+            continue;
+        }
+
+        AttendanceRecord r;
+        memset(&r, 0, sizeof(r));
+        r.empID = (int)id;
+        r.day = day;
+        r.timeIn = (unsigned short)timeIn;
+        r.hoursWorked = hoursToHundredths((float)hours);
+        r.status = (AttendanceStatus)status;
+        r.isLate = late != 0.0;
+        r.overtimeHours = hoursToHundredths((float)overtime);
+
+        if (monthOfDay(r.day) != activePartitionMonth) {
+            other[otherCount++] = r;
+            if (otherCount == CSV_IMPORT_BATCH) {
+                rejected += mergeImportedAttendance(other, otherCount, &imported, &duplicates);
+                otherCount = 0;
             }
+            continue;
         }
-        attendanceCount = newAttendanceCount;
-        
-        saveToFile();
-        saveAttendanceToFile();
-        
-        printf("\n\t\t\t\t\tEmployee '%s' (ID: %d) Removed successfully.\n", deletedName, deletedID);
-    } else {
-        printf("\n\t\t\t\t\tRemoval cancelled. No changes made.\n");
+        if (dayIndexGet(r.empID, r.day) != -1) {
+            duplicates++;
+            continue;
+        }
+        if (appendAttendanceRecord(&r) < 0) {
+            fprintf(stderr, "import-attendance-csv: out of memory at %s:%d\n", path, csv.lineNo);
+            failed = 1;
+            break;
+        }
+        importedActive++;
     }
-    
-    pressEnterToContinue();
+    csvClose(&csv);
+
+    if (importedActive > 0) saveAttendanceToFile();
+    imported += importedActive;
+    rejected += mergeImportedAttendance(other, otherCount, &imported, &duplicates);
+    free(other);
+    printf("Imported %d records (%d duplicates skipped, %d rejected).\n", imported, duplicates, rejected);
+    return failed || rejected > 0 ? 1 : 0;
 }
 
 
@@ -1555,35 +8330,36 @@ void removeEmployee(void) {
 
 
 
-// ADMIN AND MAIN MENU
-
-// Verifies admin PIN for accessing admin functions
-int verifyPin(void) {
-    int pin;
-    int attempts = 3;
-    
-    while (attempts > 0) {
-        system(CLEAR_COMMAND);
-        printf("\n\t\t\t\t                                    %d Attempts remaining ", attempts);
-        printf("\n\n\t\t\t\t                                   Enter Admin PIN (0000): ");
-        if (scanf("%d", &pin) != 1) {
-            clearInputBuffer();
-            printf("\t\t\t\t                             Invalid input. Please enter numbers only.\n");
-            attempts--;
-            continue;
-        }
-        clearInputBuffer();
-        if (pin == ADMIN_PIN) {
-            printf("\n\t\t\t\t                                          Login successful.\n");
-            return 1;
-        } else {
-            printf("\t\t\t\t                                          Login failed.\n");
-            attempts--;
-        }
+// Writes a month's attendance (default: the current month) as CSV in the import-attendance-csv
+// layout, to path or to standard output when path is "-"
+int batchExportAttendanceCsv(const char *path, const char *monthText) {
+    int month = monthText ? parsePartitionMonth(monthText) : currentPartitionMonth();
+    if (month < 0) {
+        fprintf(stderr, "export-attendance-csv: expected a month as YYYY-MM, got %s\n", monthText);
+        return 2;
     }
-    
-    printf("\n\t\t\t\t                             Too many failed attempts. Access denied.\n");
-    return 0;
+    const ChunkedStore *store;
+    int count;
+    attendanceForMonth(month, &store, &count);
+
+    int toStdout = strcmp(path, "-") == 0;
+    FILE *out = toStdout ? stdout : fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "export-attendance-csv: cannot create %s\n", path);
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, CSV_CHUNK_SIZE);
+    fprintf(out, "empID,date,timeIn,hoursWorked,status,isLate,overtimeHours\n");
+    for (int i = 0; i < count; i++) {
+        const AttendanceRecord *r = storeAt(store, i);
+        char date[11], timeBuf[6];
+        formatDayNumber(r->day, date);
+        formatTimeOfDay(r->timeIn, timeBuf);
+        fprintf(out, "%d,%s,%s,%.2f,%s,%d,%.2f\n", r->empID, date, timeBuf, r->hoursWorked / 100.0,
+                AttendanceStatusNames[r->status], r->isLate, r->overtimeHours / 100.0);
+    }
+    if (toStdout) return fflush(out) == 0 ? 0 : 1;
+    return fclose(out) == 0 ? 0 : 1;
 }
 
 
@@ -1593,71 +8369,32 @@ int verifyPin(void) {
 
 
 
-// Displays and handles the admin control panel menu
-void adminMenu(void) {
-    system(CLEAR_COMMAND);
-    int choice;
-    do {
-        printf("\n\n\t\t\t\t                                        ADMIN CONTROL PANEL                \n");
-        printf("\n\n\t\t\t\t                                        - RECORD  SYSTEM -                      \n");
-        printf("\t\t\t\t                                    1. VIEW ALL EMPLOYEE RECORD               \n");
-        printf("\t\t\t\t                                    2. ADD    NEW      EMPLOYEE                    \n");
-        printf("\t\t\t\t                                    3. UPDATE  EMPLOYEE  DETAIL                  \n");
-        printf("\t\t\t\t                                    4. REMOVE          EMPLOYEE                       \n");
-        printf("\t\t\t\t                                    5. EMPLOYEE SORTING OPTIONS                         \n");
-        printf("\n\n\t\t\t\t                                        - ATTENDANCE RECORD -                   \n");
-        printf("\t\t\t\t                                    6. ATTENDANCE     DASHBOARD                     \n");
-        printf("\t\t\t\t                                    7. VIEW          ATTENDANCE                       \n");
-        printf("\n\n\t\t\t\t                                       - SALARY COMPUTATION -                            \n");
-        printf("\t\t\t\t                                    8. VIEW MONTHLY SALARY COMPUTATION            \n");
-        printf("\t\t\t\t                                    9. GENERATE  SLIP   BY   ID                       \n");
-    printf("\n\t\t\t\t                                    10. BACK     TO    MAIN MENU                              \n");
-        printf("\n\n\t\t\t\t                                          Choice: ");
+// Prints each employee's attendance totals for a month (default: the current month) as CSV
+int batchAttendanceReport(const char *monthText) {
+    int month = monthText ? parsePartitionMonth(monthText) : currentPartitionMonth();
+    if (month < 0) {
+        fprintf(stderr, "attendance-report: expected a month as YYYY-MM, got %s\n", monthText);
+        return 2;
+    }
 
-        if (scanf("%d", &choice) != 1) {
-            printf("\n\t\t\t\t                             2.   Invalid input. Please enter a number.\n");
-            clearInputBuffer();
-            continue;
-        }
-        clearInputBuffer();
+    const ChunkedStore *store;
+    int count;
+    attendanceForMonth(month, &store, &count);
+    AttendanceSummary *summaries = malloc((size_t)(employeeCount ? employeeCount : 1) * sizeof(AttendanceSummary));
+    if (!summaries) {
+        fprintf(stderr, "attendance-report: out of memory\n");
+        return 1;
+    }
+    summarizeAttendance(store, count, summaries);
 
-        switch (choice) {
-            case 1: viewEmployees();              break;
-            case 2: addEmployee();                break;
-            case 3: updateEmployee();             break;
-            case 4: removeEmployee();             break;
-            case 5: {
-                int sortChoice = 0;
-                do {
-                    system(CLEAR_COMMAND);
-                    printf("\n\t\t\t\t                                        EMPLOYEE SORTING OPTIONS\n");
-                    printf("\t\t\t\t                                        1. Sort by ID\n");
-                    printf("\t\t\t\t                                        2. Sort by Name\n");
-                    printf("\t\t\t\t                                        3. Back\n");
-                    sortChoice = getIntInput("\n\t\t\t\t                                          Choice: ", 1, 3);
-                    if (sortChoice == 1) {
-                        sortEmployeesByID();
-                        pressEnterToContinue();
-                    } else if (sortChoice == 2) {
-                        sortEmployeesByName();
-                        pressEnterToContinue();
-                    }
-                } while (sortChoice != 3);
-                break;
-            }
-            case 6: attendanceMenu();             break;
-            case 7: viewAttendance(); break;
-            case 8: calculateAndDisplaySalary();  break;
-            case 9: {
-                int id = getIntInput("\n\t\t\t\t                                Enter Employee ID for Salary Slip: ", 1000000, 9999999);
-                displayEmployeeSalarySlip(id);
-                break;
-            }
-            case 10: printf("\n\t\t\t\t                             2.   Logging out of Admin.\n"); break;
-            default: printf("\n\t\t\t\t                             2.   Invalid choice. Please select 1-10.\n");
-        }
-        if (choice != 9) pressEnterToContinue();
-    } while (choice != 9);
+    printf("empID,name,daysWorked,daysAbsent,overtimeHours\n");
+    for (int i = 0; i < employeeCount; i++) {
+        const Employee *e = employeeAt(i);
+        printf("%d,\"%s\",%d,%d,%.2f\n", e->empID, e->name, summaries[i].daysWorked, summaries[i].daysAbsent,
+               summaries[i].overtimeHours);
+    }
+    free(summaries);
+    return 0;
 }
 
 
@@ -1667,50 +8404,75 @@ void adminMenu(void) {
 
 
 
-// Displays and handles the main menu of the system
-void mainMenu(void) {
-    int choice;
-    do {
-        system(CLEAR_COMMAND);
-        printf("\n\n\n\t\t\t    ** ** **  ** **      ** **  ** ** **   **           ** ** **      **        **    ** ** **    ** ** **     \n");
-        printf("\t\t\t    **        **  **    **  **  **     **  **         **        **     **      **     **          **                 \n");
-        printf("\t\t\t    **        **   **  **   **  **     **  **        **          **     **    **      **          **                 \n");
-        printf("\t\t\t    ** ** **  **     **     **  ** ** **   **        **          **      **  **       ** ** **    ** ** **           \n");
-        printf("\t\t\t    **        **            **  **         **        **          **        **         **          **                 \n");
-        printf("\t\t\t    **        **            **  **         **        **          **        **         **          **                 \n");
-        printf("\t\t\t    **        **            **  **         **         **        **         **         **          **                 \n");
-        printf("\t\t\t    ** ** **  **            **  **         ** ** **     ** ** **           **         ** ** **    ** ** **           \n");
-        printf("\n\t\t\t\t                                       RECORD SYSTEM           \n\n");
-        printf("\n\n\t\t\t\t                             1.         ADMIN LOGIN           ");
-        printf("\n\n\t\t\t\t                             2.   VIEW ALL EMPLOYEE RECORDS     ");
-        printf("\n\n\t\t\t\t                             3.         EXIT SYSTEM             ");
-        printf("\n\n\n\t\t\t\t                                          Choice: ");
+// Writes every computed payslip as separate files in dir, or into one archive
+int batchExportPayslips(const char *dir, const char *archivePath) {
+    int written = 0;
+    int ok = exportAllPayslips(dir, archivePath, &written);
+    if (!ok) fprintf(stderr, "export-payslips: some salary slips could not be written\n");
+    printf("Wrote %d payslips.\n", written);
+    return ok ? 0 : 1;
+}
 
-        if (scanf("%d", &choice) != 1) {
-            printf("\n\t\t\t\t                             Invalid input. Please enter a number.\n");
-            clearInputBuffer();
-            continue;
-        }
 
-        clearInputBuffer();
 
-        switch (choice) {
-            case 1:
-                if (verifyPin()) adminMenu();
-                else pressEnterToContinue();
-                break;
-            case 2:
-                viewEmployees();
-                pressEnterToContinue();
-                break;
-            case 3:
-                printf("\n\t\t\t\t                            Exiting system. All changes saved.\n");
-                break;
-            default:
-                printf("\n\t\t\t\t                            Invalid choice. Please select 1-3.\n");
-                pressEnterToContinue();
+
+
+
+
+
+// Runs one batch subcommand; returns the process exit code (0 ok, 1 failed, 2 usage)
+int runCommandLine(int argc, char *argv[]) {
+    const char *command = argv[1];
+    int status;
+    if (strcmp(command, "compute-payroll") == 0 && argc <= 3) {
+        status = batchComputePayroll();
+        if (status == 0) {
+            FILE *out = argc == 3 ? fopen(argv[2], "w") : stdout;
+            if (!out) {
+                fprintf(stderr, "compute-payroll: cannot create %s\n", argv[2]);
+                return 1;
+            }
+            fprintf(out, "empID,name,daysWorked,dailyRate,basicSalary,grossPay,sss,philHealth,pagIBIG,incomeTax,totalDeduction,netSalary\n");
+            for (int i = 0; i < employeeCount; i++) {
+                const Employee *e = employeeAt(i);
+                Money totalDeduction = e->lastSSS + e->lastPhilHealth + e->lastPagIBIG + e->lastIncomeTax;
+                fprintf(out, "%d,\"%s\",%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+                        e->empID, e->name, e->daysWorked, PESOS(e->lastDailyRate), PESOS(e->lastDailyRate * e->daysWorked),
+                        PESOS(e->lastGrossPay), PESOS(e->lastSSS), PESOS(e->lastPhilHealth), PESOS(e->lastPagIBIG),
+                        PESOS(e->lastIncomeTax), PESOS(totalDeduction), PESOS(e->lastNetPay));
+            }
+            if (out != stdout && fclose(out) != 0) status = 1;
         }
-    } while (choice != 3);
+    } else if (strcmp(command, "import-attendance") == 0 && argc == 3) {
+        status = batchImportAttendance(argv[2]);
+    } else if (strcmp(command, "import-employees-csv") == 0 && argc == 3) {
+        status = batchImportEmployeesCsv(argv[2]);
+    } else if (strcmp(command, "export-employees-csv") == 0 && argc <= 3) {
+        status = batchExportEmployeesCsv(argc == 3 ? argv[2] : NULL);
+    } else if (strcmp(command, "import-attendance-csv") == 0 && argc == 3) {
+        status = batchImportAttendanceCsv(argv[2]);
+    } else if (strcmp(command, "export-attendance-csv") == 0 && (argc == 3 || argc == 4)) {
+        status = batchExportAttendanceCsv(argv[2], argc == 4 ? argv[3] : NULL);
+    } else if (strcmp(command, "attendance-report") == 0 && argc <= 3) {
+        status = batchAttendanceReport(argc == 3 ? argv[2] : NULL);
+    } else if (strcmp(command, "export-payslips") == 0 && argc <= 3) {
+        status = batchExportPayslips(argc == 3 ? argv[2] : NULL, NULL);
+    } else if (strcmp(command, "export-payslip-archive") == 0 && argc <= 3) {
+        status = batchExportPayslips(NULL, argc == 3 ? argv[2] : PAYSLIP_ARCHIVE_FILE);
+    } else if (strcmp(command, "serve") == 0 && argc <= 3) {
+        status = serveKiosk(argc == 3 ? atoi(argv[2]) : KIOSK_DEFAULT_PORT);
+    } else if (strcmp(command, "export-binary") == 0 && argc == 2) {
+        exportBinarySnapshots();
+        status = 0;
+    } else if (strcmp(command, "export-text") == 0 && argc == 2) {
+        exportTextFiles();
+        status = 0;
+    } else {
+        fprintf(stderr, "Unknown command or wrong arguments: %s\n\n", command);
+        printUsage(argv[0]);
+        return 2;
+    }
+    return status;
 }
 
 
@@ -1721,12 +8483,56 @@ void mainMenu(void) {
 
 
 // Main entry point of the program
-int main(void) {
-    printf("\t\t\t\t                             Loading employee data...\n");
+int main(int argc, char *argv[]) {
+    int status = 0;
+    loadSettings();
+    const char *quietEnv = getenv(QUIET_ENV_VAR);
+    if (quietEnv && quietEnv[0]) quietMode = strcmp(quietEnv, "0") != 0;
+    if (argc > 1 && (strcmp(argv[1], "--quiet") == 0 || strcmp(argv[1], "-q") == 0)) {
+        quietMode = 1;
+        argv[1] = argv[0];
+        argv++;
+        argc--;
+    }
+
+    batchMode = argc > 1;
+    // Exports and reports only read the data files, so loading must not change them either
+    readOnlyMode = batchMode && (strcmp(argv[1], "export-employees-csv") == 0 ||
+                                 strcmp(argv[1], "export-attendance-csv") == 0 ||
+                                 strcmp(argv[1], "attendance-report") == 0 ||
+                                 strcmp(argv[1], "export-payslips") == 0 ||
+                                 strcmp(argv[1], "export-payslip-archive") == 0);
+
+    if (argc > 1 && (strcmp(argv[1], "help") == 0 || strcmp(argv[1], "--help") == 0)) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    // The benchmark generates its own data and must never load or save the real files
+    if (argc > 1 && strcmp(argv[1], "benchmark") == 0) return runBenchmark(argc, argv);
+
+    if (argc == 1) printf("\t\t\t\t                             Loading employee data...\n");
     loadFromFile();
     loadAttendanceFromFile();
-    mainMenu();
-    return 0;
+    if (argc > 1) {
+        status = runCommandLine(argc, argv);
+    } else {
+        mainMenu();
+    }
+    if (!readOnlyMode) {
+        flushPendingSaves(1);
+        compactAttendanceJournal();
+    }
+    freeEmployeeIDIndex();
+    freeEmployeeIDAllocator();
+    freeEmployeeIndexes();
+    freeAttendanceDayIndex();
+    freeAttendanceOrderIndex();
+    freePartitionCache();
+    free(pendingSaves.changes);
+    storeFree(&employeeStore);
+    storeFree(&attendanceStore);
+    return status;
 }
 
 
@@ -0,0 +1,16 @@
+@echo off
+echo Compiling Employee Record System with optimizations for benchmarking...
+
+:: Same sources as compile.bat, optimized so the timings reflect a release build
+gcc EmployeeRecordSystem.c -o EmployeeRecordSystem.exe -O2 -w -lm -lws2_32
+
+if %errorlevel% neq 0 (
+    echo Compilation failed. Please check the error messages above.
+    pause
+    exit /b 1
+)
+
+:: Arguments are passed through: benchmark.bat [employees] [months]
+:: Results are appended to bench_output.txt; generated data goes into bench_data\
+EmployeeRecordSystem.exe --quiet benchmark %*
+pause
@@ -2,13 +2,13 @@
 echo Compiling Employee Record System...
 
 :: First, try to compile with just the basic options
-gcc EmployeeRecordSystem.c -o EmployeeRecordSystem.exe -w
+gcc EmployeeRecordSystem.c -o EmployeeRecordSystem.exe -w -lws2_32
 
 :: Check if compilation was successful
 if %errorlevel% neq 0 (
     echo Compilation failed! Trying alternative compilation...
     :: Try alternate compilation with additional libraries
-    gcc EmployeeRecordSystem.c -o EmployeeRecordSystem.exe -w -lm
+    gcc EmployeeRecordSystem.c -o EmployeeRecordSystem.exe -w -lm -lws2_32
 )
 
 :: Check final result